@@ -0,0 +1,166 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// Microbenchmarks of hot paths: transformation of vectors/stems/elements,
+// traversal of whole tree per speed scale, flash palette and snapshot
+// loading. No window is opened - runs also on display-less machine:
+//   meson test --benchmark   (or directly: microbench [snapshot file])
+// Every case is repeated for at least cMinTime, time per operation printed.
+
+#include "cfg_toml.h"
+#include "colors.h"
+#include "elem_store.h"
+#include "fluctuate.h"
+#include "fractal.h"
+#include "opt_lyra.h"
+#include "pipeline.h"
+#include "transform.h"
+#include "traverse.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+// Walk (compute) frame from input into result - see recurrence.cpp
+long elements_redraw(ElemStore & store, ParallelWalk & walk,
+                     FrameInput & input, FrameResult & result);
+
+// Results kept here - so benchmarked calls are not optimized out
+static volatile float s_sink;
+
+struct MicroBench {
+  using Clock = std::chrono::steady_clock;
+  constexpr static std::chrono::milliseconds cMinTime { 200 };
+
+  // Call op (doing opsPerCall operations) until cMinTime elapsed
+  template<typename Op>
+  static void run(std::string_view name, long opsPerCall, Op && op) {
+    long calls { 0 };
+    const Clock::time_point start { Clock::now() };
+    Clock::duration elapsed {};
+    do {
+      op();
+      ++calls;
+      elapsed = Clock::now() - start;
+    } while (elapsed < cMinTime);
+    const double ns { std::chrono::duration<double, std::nano>(elapsed).count() };
+    std::printf("%-40.*s %14.1f ns/op %12ld ops\n", static_cast<int>(name.size()), name.data(),
+                ns / (calls * opsPerCall), calls * opsPerCall);
+  }
+};
+
+
+static void bench_vec_rotate() {
+  Vec2D vec { 100.0f, 100.0f, 50.0f, 0.0f, 50.0f, 0.0f };
+  MicroBench::run("Vec2D::rotate", 1000, [&vec] {
+    for (int i { 0 }; i < 1000; ++i) {
+      vec.rotate(0.01f, 1.0f);
+    }
+    s_sink = vec.dx;
+  });
+}
+
+static void bench_reposition_stem() {
+  Stem parent {};
+  parent.vec_xy = { 100.0f, 100.0f, 50.0f, 20.0f, 50.0f, 20.0f };
+  MicroBench::run("Stem::reposition_stem", 1000, [&parent] {
+    for (int i { 0 }; i < 1000; ++i) {
+      Stem stem { parent };
+      stem.reposition_stem(0.5f, Stem::thick1);
+      s_sink = stem.x1;
+    }
+  });
+}
+
+static void bench_transform_vec_stem(const MovFluctuate & algo) {
+  Element parent;
+  parent.initPrimary();
+  Element child { parent };
+  child.index = 1;
+  child.b_type = upBranch;
+  MicroBench::run("Element::transform_vec_stem", 1000, [&] {
+    for (int i { 0 }; i < 1000; ++i) {
+      // every order has its own transformation
+      child.order = static_cast<short>(1 + i % cFrac::NrOfOrders);
+      child.stem_xy = parent.stem_xy;
+      child.transform_vec_stem(algo.algo_data_fluctuate);
+      s_sink = child.stem_xy.vec_xy.dx;
+    }
+  });
+}
+
+// Whole tree (no culling) walked and collected for drawing per speed scale
+static void bench_traversal(const OptParams & options) {
+  ElemStore store;
+  ParallelWalk walk { 1 };
+  FrameResult result { 1 };
+  for (int speed { 0 }; speed < TranAlg::SpeedScaleDataSize; ++speed) {
+    OptParams speedOptions { options };
+    speedOptions.optSpeed = speed;
+    const MovFluctuate algo { speedOptions };
+    Element prim;
+    prim.initPrimary();
+    FrameInput input { frame_snapshot(prim, algo, false) };
+    // elements of this speed created before measurement
+    store.reset();
+    long visited { elements_redraw(store, walk, input, result) };
+    const std::string name { "traversal speed " + std::to_string(speed) +
+                             " (" + std::to_string(visited) + " elements)" };
+    MicroBench::run(name, visited, [&] {
+      visited = elements_redraw(store, walk, input, result);
+    });
+  }
+}
+
+static void bench_flash_color_pallet() {
+  ColorPal colorPal;
+  unsigned int i { 0 };
+  MicroBench::run("ColorPal::calc_flash_color_pallet", 1, [&] {
+    ++i;
+    colorPal.calc_flash_color_pallet(sf::Color(i % 256, (i * 7) % 256, (i * 13) % 256));
+    s_sink = ColorPal::s_flash_col_palet[0].begin_c.r;
+  });
+}
+
+static void bench_snapshot_loading(const std::string & file) {
+  Element prim;
+  T_Algo_Arr algo {};
+  T_Col_Palet colors {};
+  // File parsed and its first snapshot loaded
+  MicroBench::run("CfgToml file load", 1, [&] {
+    CfgToml cfgToml;
+    s_sink = cfgToml.loadNextConfig(file, prim, algo, colors).size();
+  });
+  // Next snapshot of already parsed file
+  CfgToml cfgToml;
+  MicroBench::run("CfgToml next snapshot", 1, [&] {
+    s_sink = cfgToml.loadNextConfig(file, prim, algo, colors).size();
+  });
+}
+
+
+int main(int argc, const char** argv)
+{
+  const std::string snapshotFile { argc > 1 ? argv[1] : std::string(cPath::cDefaultSnapshot) };
+
+  // Fully grown static fractal
+  OptParams options;
+  options.optGrowingOff = true;
+  const MovFluctuate algo { options };
+
+  bench_vec_rotate();
+  bench_reposition_stem();
+  bench_transform_vec_stem(algo);
+  bench_traversal(options);
+  bench_flash_color_pallet();
+  bench_snapshot_loading(snapshotFile);
+
+  return 0;
+}
@@ -8,6 +8,7 @@
 // THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "aggreg.h"
+#include "aux_func.h"
 #include "dbg_report.h"
 #include "animation.h"
 #include "colors.h"
@@ -71,7 +72,7 @@ void MainProgAggr::resetConfig(bool keyAction) {
 }
   
 // (Re)Draw some possible artefacts on top of fractal structure
-void MainProgAggr::draw_artefacts(sf::RenderWindow & win, AutoScale & rescale) {
+void MainProgAggr::draw_artefacts(sf::RenderTarget & win, AutoScale & rescale) {
   // Draw either rescaling or Lights structure
   if (rescale.ifRescaleActive()) {
     float scale = rescale.getShrinkCumulativeFactor();
@@ -100,6 +101,26 @@ void MainProgAggr::draw_artefacts(sf::RenderWindow & win, AutoScale & rescale) {
   logtxt.snapshot_draw(win);
 }
 
+// Move artefacts (light) without drawing them - output without overlay
+void MainProgAggr::move_artefacts(AutoScale & rescale) {
+  if (!rescale.ifRescaleActive()) {
+    // no keyboard polling - output may have no display server
+    lightS.light_move(false);
+  }
+}
+
+// Next snapshot from file becomes current configuration
+void MainProgAggr::load_next_snapshot(Element& prim_element) {
+  logtxt.load_next_snapshot( prim_element, movFluctuate.algo_data, ColorPal::s_col_palet);
+  // Refresh also flash color pallete
+  colorPal.calc_flash_color_pallet(LightS::s_lightColor);
+  // Refresh final transformation algo with optional growing animation
+  movFluctuate.refreshWithRestartGrowing();
+  // In case of change of leaf contruction reset flash
+  colorPal.reset_flash_algo();
+  movFluctuate.resumeTimeFlow();
+}
+
 // General key decodation
 // can be dispatched to subordinate classes/structs
 void MainProgAggr::key_decodation(const sf::Keyboard::Key key,
@@ -127,14 +148,7 @@ void MainProgAggr::key_decodation(const sf::Keyboard::Key key,
   } 
   else if (key == sf::Keyboard::Key::F3) {
     // Retrieve fractal snapshot/configuration from file
-    logtxt.load_next_snapshot( prim_element, movFluctuate.algo_data, ColorPal::s_col_palet);
-    // Refresh also flash color pallete
-    colorPal.calc_flash_color_pallet(LightS::s_lightColor);
-    // Refresh final transformation algo with optional growing animation
-    movFluctuate.refreshWithRestartGrowing();
-    // In case of change of leaf contruction reset flash
-    colorPal.reset_flash_algo();
-    movFluctuate.resumeTimeFlow();
+    load_next_snapshot(prim_element);
     // Allow display snapshot description (or time)
     logtxt.startSnapshotDraw();
   } 
@@ -184,7 +198,8 @@ void MainProgAggr::key_decodation(const sf::Keyboard::Key key,
 }
 
 // Single demo step
-void MainProgAggr::demoGenerator(Element & primEl, AutoScale & autoScale) {
+void MainProgAggr::demoGenerator(Element & primEl, ElemStore & elemStore,
+                                 AutoScale & autoScale) {
   // Counter for this Demo changes - it can be reset by demoRand
   static long int ownDemoCnt { cFrac::DemoInitCnt };
   // total Counter of demos
@@ -207,7 +222,7 @@ void MainProgAggr::demoGenerator(Element & primEl, AutoScale & autoScale) {
     // Initialize other subordinate generators
     (void)lightS.demoGenerator(cFrac::DemoInitCnt, 0);
     // Further initialization like seed generation
-    srand(time(NULL));
+    myAux::seed_random();
     allDemoCnt = cFrac::DemoInitCnt +1;
     }
   else {
@@ -225,6 +240,7 @@ void MainProgAggr::demoGenerator(Element & primEl, AutoScale & autoScale) {
   if (demoRand(500, ownDemoCnt) or movFluctuate.stopAtZero) {
     // all reset
     primEl.initPrimary();
+    elemStore.reset();
     autoScale.resetAutoScale();
     // Next Leaf construction
     movFluctuate.rotate_pre_cfg();
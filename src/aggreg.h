@@ -12,6 +12,7 @@
 #include "autoscale.h"
 #include "colors.h"
 #include "dbg_report.h"
+#include "elem_store.h"
 #include "fractal.h"
 #include "light.h"
 #include "logtxt.h"
@@ -36,9 +37,15 @@ struct MainProgAggr {
   // General key decodation
   // can be dispatched to subordinate classes/structs
   void key_decodation(const sf::Keyboard::Key key, Element & prim_element);
+
+  // Retrieve next fractal snapshot/configuration from file (as F3 key)
+  void load_next_snapshot(Element & prim_element);
   
   // (Re)Draw some possible artefacts on top of fractal structure
-  void draw_artefacts(sf::RenderWindow & win, AutoScale & rescale);
+  void draw_artefacts(sf::RenderTarget & win, AutoScale & rescale);
+
+  // Move artefacts (light) without drawing them - output without overlay
+  void move_artefacts(AutoScale & rescale);
 
   // Post Construction (very Initialization) Init and sync
   void postInitSync(void);
@@ -50,7 +57,7 @@ struct MainProgAggr {
   std::string prepareSnapshotData(void);
   
   // Single demo step
-  void demoGenerator(Element &primEl, AutoScale &autoScale);
+  void demoGenerator(Element &primEl, ElemStore &elemStore, AutoScale &autoScale);
 
   // aggregate of Structs/classes
   LogText logtxt;     // Text, Logging snapshots
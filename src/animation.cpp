@@ -207,7 +207,7 @@ bool MovAnim::demoGenerator(long int demoCnt, bool resetAction) {
   
   if (demoCnt == cFrac::DemoInitCnt) {
     // seed generation
-    srand(time(NULL));
+    myAux::seed_random();
   } else if (resetAction) {
     lastActionDistance = 0;
   }
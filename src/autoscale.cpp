@@ -11,34 +11,39 @@
 #include "dbg_report.h"
 #include "fractal.h"
 #include "transform.h"
+#include <algorithm>
+#include <cmath>
 
 using VecMinMax = Dbg::VecMinMax;
   
 // initialize data on new frame/cycle
 void AutoScale::cycleStart() {
-  m_minmax.minX = cFrac::WindowXsize; // end of window 
-  m_minmax.minY = cFrac::WindowYsize; // end of window 
-  m_minmax.maxX = 0;
-  m_minmax.maxY = 0;
+  m_minmax = cMinMaxStart; // end of window as minimum
 }
 
 // collect vector sizes to find drawing Min/Max per frame/cycle
-void AutoScale::findMinMax(const Vec2D & vec) {
-  if (m_minmax.minX > vec.x) { m_minmax.minX = vec.x;}
+void AutoScale::extendMinMax(VecMinMax & minmax, float x, float y, float dx, float dy) {
+  if (minmax.minX > x) { minmax.minX = x;}
   // consider that vector can also go backward
-  if (m_minmax.minX > vec.x + vec.dx) { m_minmax.minX = vec.x + vec.dx;}
-  if (m_minmax.maxX < vec.x) { m_minmax.maxX = vec.x;}
-  if (m_minmax.maxX < vec.x + vec.dx) { m_minmax.maxX = vec.x + vec.dx;}
-  if (m_minmax.minY > vec.y) { m_minmax.minY = vec.y;}
-  if (m_minmax.minY > vec.y + vec.dy) { m_minmax.minY = vec.y + vec.dy;}
-  if (m_minmax.maxY < vec.y) { m_minmax.maxY = vec.y;}
-  if (m_minmax.maxY < vec.y + vec.dy) { m_minmax.maxY = vec.y + vec.dy;}
+  if (minmax.minX > x + dx) { minmax.minX = x + dx;}
+  if (minmax.maxX < x) { minmax.maxX = x;}
+  if (minmax.maxX < x + dx) { minmax.maxX = x + dx;}
+  if (minmax.minY > y) { minmax.minY = y;}
+  if (minmax.minY > y + dy) { minmax.minY = y + dy;}
+  if (minmax.maxY < y) { minmax.maxY = y;}
+  if (minmax.maxY < y + dy) { minmax.maxY = y + dy;}
+}
+
+void AutoScale::mergeMinMax(VecMinMax & into, const VecMinMax & minmax) {
+  if (into.minX > minmax.minX) { into.minX = minmax.minX;}
+  if (into.maxX < minmax.maxX) { into.maxX = minmax.maxX;}
+  if (into.minY > minmax.minY) { into.minY = minmax.minY;}
+  if (into.maxY < minmax.maxY) { into.maxY = minmax.maxY;}
 }
 
 // get Min,Max per frame in real size;
 // performe single step of rescale if needed
 void AutoScale::cycleResume(Element & prim) {
-  constexpr static float cShrinkStep { 0.992f };
 
   // Collecting picture contour sizes for whole program duration
   Dbg::find_minmax(m_minmax);
@@ -49,6 +54,7 @@ void AutoScale::cycleResume(Element & prim) {
       // Rescale Activation
       Dbg::report_info("Rescale Activation ", m_rescaleActive );
       m_rescaleActive = true;
+      m_easeLeft = cEaseFrames;
 
     } else if(rescaleFinished(m_minmax) and m_rescaleActive) {
       // Rescale Deactivation
@@ -59,56 +65,63 @@ void AutoScale::cycleResume(Element & prim) {
     }
 
     if (m_rescaleActive) {
-      // Realize single step of rescale
-      VecDelta delta = centerPicture(); // uses Usable (not absolute) center
-      // first center picure within window
-      if ((delta.dx != cDeltaNoMove.dx) or (delta.dy != cDeltaNoMove.dy)) {
-        // move to center by calculated step
-        prim.stem_xy.repositionStemAbsolute(delta.dx, delta.dy);
-      } else {
-        // then shrink if needed (by factor)
-        m_cumulativeFactor *= cShrinkStep;
-        prim.stem_xy.shrinkStemCenter(cShrinkStep, m_cumulativeFactor,
+      // Realize single step of rescale: part of remaining move and shrink
+      // (target from extent of current frame - picture may still change)
+      const RescaleTarget target { rescaleTarget() };
+      const float stepDx { target.dx / m_easeLeft };
+      const float stepDy { target.dy / m_easeLeft };
+      const float stepFactor { std::pow(target.factor, 1.0f / m_easeLeft) };
+
+      // first move picture center towards window usable center
+      prim.stem_xy.repositionStemAbsolute(stepDx, stepDy);
+      // then shrink (around usable center) if needed
+      if (stepFactor < 1.0f) {
+        m_cumulativeFactor *= stepFactor;
+        prim.stem_xy.shrinkStemCenter(stepFactor, m_cumulativeFactor,
                                       winUsable_x_center, winUsable_y_center);
       }
+
+      // Target shall be reached - otherwise (e.g. growing) next easing
+      if (--m_easeLeft == 0) {
+        m_easeLeft = cEaseFrames;
+      }
     }
   }
 }
 
 
-// Calculate delta vector to center picure (in window) in multiple small steps
-// uses accuracy units
-AutoScale::VecDelta AutoScale::centerPicture(void) {
-  
-  static_assert(cAcceptedDiff > cSmallStep, 
-    "Accepted diffrence must be > than small change; otherwise algo will not conclude");
+// Complete move and shrink fitting picture of latest frame into window
+// (within rescale finish margins) - centered in window usable area
+AutoScale::RescaleTarget AutoScale::rescaleTarget(void) const {
 
   static_assert(winUsable_y_center > cTran::cYcenterM, 
               "Usable vertical center below real one (Y axis down)");
 
   // Calculate center position of latest frame picture
-  int pic_x_center = (m_minmax.minX + m_minmax.maxX) /2;
-  int pic_y_center = (m_minmax.minY + m_minmax.maxY) /2;
-  
-
-  // complete move required
-  VecDelta delta {};
-  delta.dx = winUsable_x_center - pic_x_center;
-  delta.dy = winUsable_y_center - pic_y_center;
-
-  if ((abs(delta.dx) <= cAcceptedDiff) and
-      (abs(delta.dy) <= cAcceptedDiff)) {\
-    return cDeltaNoMove; // no movement needed anymore if very small diffrence
+  const float pic_x_center { (m_minmax.minX + m_minmax.maxX) / 2.0f };
+  const float pic_y_center { (m_minmax.minY + m_minmax.maxY) / 2.0f };
+
+  RescaleTarget target {};
+  target.dx = winUsable_x_center - pic_x_center;
+  target.dy = winUsable_y_center - pic_y_center;
+
+  // Room inside finish margins - with accepted difference left
+  // (e.g. for integer rounding of shrinking)
+  constexpr static float cFitWidth { cFrac::WindowXsize
+                                     - 2.0f * (cMargin + cHistMargin + cAcceptedDiff) };
+  constexpr static float cFitHeight { cFrac::WindowYsize
+                                      - (cTopMargin + cHistMargin + cAcceptedDiff)
+                                      - (cMargin + cHistMargin + cAcceptedDiff) };
+  const float pic_width { static_cast<float>(m_minmax.maxX - m_minmax.minX) };
+  const float pic_height { static_cast<float>(m_minmax.maxY - m_minmax.minY) };
+  target.factor = 1.0f;
+  if (pic_width > cFitWidth) {
+    target.factor = cFitWidth / pic_width;
+  }
+  if (pic_height > cFitHeight) {
+    target.factor = std::min(target.factor, cFitHeight / pic_height);
   }
-      
-  // move to center by small step
-  VecDelta stepDelta { 0, 0 };
-  if (delta.dx > cSmallStep) stepDelta.dx = cSmallStep;
-  if (delta.dy > cSmallStep) stepDelta.dy = cSmallStep;
-  if (delta.dx < -cSmallStep) stepDelta.dx = -cSmallStep;
-  if (delta.dy < -cSmallStep) stepDelta.dy = -cSmallStep;
-
-  return stepDelta;
+  return target;
 }
 
 
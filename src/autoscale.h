@@ -22,11 +22,14 @@
 // };
 
 // Perform (optionally) autoscale by changing size and location
-// of first element to fit whole drawing into window
+// of first element to fit whole drawing into window.
+// Extent of drawing comes from low detail walk (see ExtentPass in traverse.h);
+// rescale reaches its target (center and size) within cEaseFrames frames
 struct AutoScale
 {
   using VecMinMax = Dbg::VecMinMax;
-  struct VecDelta {int dx; int dy;};
+  // Move (in graphic points) and shrink factor of rescale
+  struct RescaleTarget {float dx; float dy; float factor;};
 
   AutoScale(bool onOff = true)
   : m_minmax{} // actual start values are set by cycleStart
@@ -45,23 +48,29 @@ struct AutoScale
   constexpr static int cTopMargin { 70 }; 
   // margin histeresis
   constexpr static int cHistMargin { 20 };
-  // NO mevement, centering, needed
-  constexpr static VecDelta cDeltaNoMove { 0, 0 };
 
   // Usable window center used throughout autoscale
   constexpr static int winUsable_x_center = cTran::cXcenterM;
   constexpr static int winUsable_y_center = cTran::cYcenterM + 
                            ((cTopMargin - cMargin) /2.0);
   
-  // Single step move (centering)
-  constexpr static float cSmallStep { 2.0 }; // 2 (graphic) points
+  // # of frames of rescale (easing to target)
+  constexpr static int cEaseFrames { 10 };
   constexpr static float cAcceptedDiff { 3.0 }; // 3 (graphic) points
 
+  // Min/Max at start of frame/cycle (nothing drawn yet)
+  constexpr static VecMinMax cMinMaxStart { cFrac::WindowXsize, cFrac::WindowYsize, 0, 0 };
+
   // initialize data for new frame/cycle
   void cycleStart();
 
     // collect vector sizes to find drawing Min/Max per frame/cycle
-  void findMinMax(const Vec2D & vec);
+  void findMinMax(const Vec2D & vec) { findMinMax(vec.x, vec.y, vec.dx, vec.dy); }
+  void findMinMax(float x, float y, float dx, float dy) { extendMinMax(m_minmax, x, y, dx, dy); }
+  // Min/Max collected separately (e.g. by other thread)
+  void mergeMinMax(const VecMinMax & minmax) { mergeMinMax(m_minmax, minmax); }
+  static void mergeMinMax(VecMinMax & into, const VecMinMax & minmax);
+  static void extendMinMax(VecMinMax & minmax, float x, float y, float dx, float dy);
   
   // get Min,Max per frame in real size
   // rescale if needed
@@ -71,6 +80,11 @@ struct AutoScale
     return m_rescaleActive;
   };
 
+  // Rescale (option) is switched On - Min/Max of whole drawing needed
+  bool ifOptionOn() const {
+    return m_optionOn;
+  }
+
   float getShrinkCumulativeFactor() const {
     return m_cumulativeFactor;
   }
@@ -93,10 +107,13 @@ struct AutoScale
   bool m_rescaleActive;
 
   float m_cumulativeFactor { 1 };
+
+  // # of frames left to reach rescale target
+  int m_easeLeft { cEaseFrames };
   
   VecMinMax getRealScale(void);
   
-  VecDelta centerPicture(void);
+  RescaleTarget rescaleTarget(void) const;
   
   bool rescaleRequired(const VecMinMax vec) const;
   bool rescaleFinished(const VecMinMax vec) const;
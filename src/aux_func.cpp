@@ -8,6 +8,9 @@
 // THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "aux_func.h"
+#include <cstdlib>
+#include <ctime>
+#include <optional>
 
 // Auxiliary functions used across project
 namespace myAux {
@@ -30,4 +33,16 @@ float radiansToZeroOneDegrees(float rad) {
     return radiansToDegrees(rad) *10.0;
 }
 
+// Fixed seed (if any) used instead of time
+static std::optional<unsigned int> s_fixedSeed;
+
+void seed_random() {
+    srand(s_fixedSeed ? *s_fixedSeed : static_cast<unsigned int>(time(NULL)));
+}
+
+void fix_random_seed(unsigned int seed) {
+    s_fixedSeed = seed;
+    srand(seed);
+}
+
 }
@@ -25,4 +25,8 @@ namespace myAux {
   // radians to 0.1deg
   float radiansToZeroOneDegrees(float rad);
 
+  // Seed of rand() - by time unless fixed one is set (e.g. benchmark)
+  void seed_random();
+  void fix_random_seed(unsigned int seed);
+
 }
@@ -0,0 +1,103 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "bench.h"
+#include "dbg_report.h"
+#include <array>
+#include <iomanip>
+#include <iostream>
+#if defined(__unix__) or defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+// Scenarios - keep them unchanged, results are compared between runs
+static const std::array<BenchScenario, 5> cScenarios {{
+  // Still fractal - computed once, then frames reused (idle window)
+  { "static", 100, 0, {}, false },
+  // Opening animation
+  { "opening", 200, 8, { { 0, sf::Keyboard::Key::O } }, false },
+  // Wind (wobbling)
+  { "wind", 200, 8, { { 0, sf::Keyboard::Key::Grave } }, false },
+  // Light moved thus flashes
+  { "light", 200, 8, {}, true },
+  // Snapshots loaded from file one after another
+  { "snapshots", 250, 8, { { 0, sf::Keyboard::Key::F3 }, { 50, sf::Keyboard::Key::F3 },
+                           { 100, sf::Keyboard::Key::F3 }, { 150, sf::Keyboard::Key::F3 },
+                           { 200, sf::Keyboard::Key::F3 } }, false },
+}};
+
+const BenchScenario * BenchScenario::find(std::string_view name) {
+  for (const BenchScenario & scenario : cScenarios) {
+    if (scenario.name == name) {
+      return &scenario;
+    }
+  }
+  return nullptr;
+}
+
+
+// Peak resident memory in kB (0 if unknown)
+static long peak_rss_kb() {
+#if defined(__unix__) or defined(__APPLE__)
+  rusage usage {};
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // in bytes
+#else
+    return usage.ru_maxrss;
+#endif
+  }
+#endif
+  return 0;
+}
+
+
+BenchOutput::BenchOutput(const BenchScenario & scenario, int threads)
+  : OffscreenOutput { scenario.frames, RasterCfg { true, threads } }
+  , m_scenario { scenario }
+  , m_results { std::cout.rdbuf() }
+  , m_allocations { Dbg::allocations() }
+  , m_start { Clock::now() }
+  , m_end { m_start }
+{
+  std::cout.rdbuf(std::cerr.rdbuf());
+  Dbg::report_info("Bench scenario: " + std::string(m_scenario.name));
+}
+
+std::optional<sf::Event> BenchOutput::pollEvent() {
+  if (m_key < m_scenario.keys.size() and m_scenario.keys[m_key].frame <= m_frame) {
+    sf::Event::KeyPressed keyPressed {};
+    keyPressed.code = m_scenario.keys[m_key].code;
+    ++m_key;
+    return sf::Event { keyPressed };
+  }
+  return std::nullopt;
+}
+
+void BenchOutput::display() {
+  ++m_frame;
+  m_end = Clock::now();
+}
+
+void BenchOutput::report(long nodes, long reused) {
+  const double seconds { std::chrono::duration<double>(m_end - m_start).count() };
+  const double perSecond { seconds > 0.0 ? 1.0 / seconds : 0.0 };
+  m_results << std::fixed << std::setprecision(3)
+      << "{\"scenario\": \"" << m_scenario.name << '"'
+      << ", \"frames\": " << m_frame
+      << ", \"seconds\": " << seconds
+      << ", \"fps\": " << m_frame * perSecond
+      << ", \"reused\": " << reused
+      << ", \"nodes\": " << nodes
+      << ", \"nodes_per_s\": " << static_cast<long>(nodes * perSecond)
+      << ", \"allocations\": " << Dbg::allocations() - m_allocations
+      << ", \"peak_rss_kb\": " << peak_rss_kb()
+      << "}" << std::endl;
+}
@@ -0,0 +1,75 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "frame_output.h"
+#include <SFML/Window/Event.hpp>
+#include <SFML/Window/Keyboard.hpp>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Deterministic benchmark (--bench <scenario>): fixed seed of rand(),
+// fixed # of frames drawn offscreen by CPU raster (no display server, no
+// frame pacing, no growing animation - full fractal from first frame) and
+// keys pressed by script - results reported as JSON,
+// e.g. to be tracked by nightly performance job. JSON line is the only
+// standard output then - everything else goes to stderr.
+
+// Scripted run of program
+struct BenchScenario {
+  // Key pressed before given frame
+  struct Key {
+    long frame;
+    sf::Keyboard::Key code;
+  };
+
+  std::string_view name;
+  long frames;
+  int speed;             // initial speed (instead of --speed)
+  std::vector<Key> keys; // ordered by frame
+  bool lightSweep;       // light swept from edge to edge
+
+  // Seed of rand() - the same for every run
+  constexpr static unsigned int cSeed { 1 };
+
+  // Scenario of given name (nullptr if unknown)
+  static const BenchScenario * find(std::string_view name);
+};
+
+// Offscreen output with scripted keys as user events.
+// Measures run of scenario: from construction till last frame displayed.
+// Takes over stdout for results (std::cout redirected to stderr till the
+// end of program, also final summary).
+struct BenchOutput : OffscreenOutput {
+  BenchOutput(const BenchScenario & scenario, int threads);
+
+  std::optional<sf::Event> pollEvent();
+  void display();
+
+  // Results as single JSON line; nodes - # of elements computed in all
+  // frames, reused - # of frames not computed (same as previous frame)
+  void report(long nodes, long reused);
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  const BenchScenario & m_scenario;
+  std::ostream m_results; // original standard output
+  std::size_t m_key { 0 }; // next scripted key
+  long m_allocations;      // heap allocations before start
+  Clock::time_point m_start;
+  Clock::time_point m_end;
+};
@@ -0,0 +1,203 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "child_kernel.h"
+#include "dbg_report.h"
+#include <cassert>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CHILD_KERNEL_X86
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#define CHILD_KERNEL_NEON
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+// # of children in sibling group
+constexpr long cGroup { 2 * cFrac::NrOfElements };
+
+// Single child: reposition, then rotate and scale (2x2 matrix)
+inline void transform_child(long i, float px, float py, float pdx, float pdy,
+                            const ChildTransforms & rules,
+                            float * x, float * y, float * dx, float * dy) {
+  x[i] = px + (pdx * rules.repos[i]);
+  y[i] = py + (pdy * rules.repos[i]);
+  dx[i] = pdx * rules.cos_scale[i] - pdy * rules.sin_scale[i];
+  dy[i] = pdx * rules.sin_scale[i] + pdy * rules.cos_scale[i];
+}
+
+void kernel_scalar(float px, float py, float pdx, float pdy, const ChildTransforms & rules,
+                   float * x, float * y, float * dx, float * dy) {
+  for (long i { 0 }; i < cGroup; ++i) {
+    transform_child(i, px, py, pdx, pdy, rules, x, y, dx, dy);
+  }
+}
+
+#ifdef CHILD_KERNEL_X86
+// SSE2 - always available on x86-64; 4 children per step
+void kernel_sse(float px, float py, float pdx, float pdy, const ChildTransforms & rules,
+                float * x, float * y, float * dx, float * dy) {
+  const __m128 vpx { _mm_set1_ps(px) };
+  const __m128 vpy { _mm_set1_ps(py) };
+  const __m128 vpdx { _mm_set1_ps(pdx) };
+  const __m128 vpdy { _mm_set1_ps(pdy) };
+  long i { 0 };
+  for (; i + 4 <= cGroup; i += 4) {
+    const __m128 repos { _mm_loadu_ps(&rules.repos[i]) };
+    const __m128 cs { _mm_loadu_ps(&rules.cos_scale[i]) };
+    const __m128 sn { _mm_loadu_ps(&rules.sin_scale[i]) };
+    _mm_storeu_ps(x + i, _mm_add_ps(vpx, _mm_mul_ps(vpdx, repos)));
+    _mm_storeu_ps(y + i, _mm_add_ps(vpy, _mm_mul_ps(vpdy, repos)));
+    _mm_storeu_ps(dx + i, _mm_sub_ps(_mm_mul_ps(vpdx, cs), _mm_mul_ps(vpdy, sn)));
+    _mm_storeu_ps(dy + i, _mm_add_ps(_mm_mul_ps(vpdx, sn), _mm_mul_ps(vpdy, cs)));
+  }
+  for (; i < cGroup; ++i) {
+    transform_child(i, px, py, pdx, pdy, rules, x, y, dx, dy);
+  }
+}
+
+#if defined(__GNUC__)
+#define CHILD_KERNEL_AVX2
+// AVX2 - compiled for this function only, used if CPU supports it;
+// 8 children per step (no FMA - same results as scalar)
+__attribute__((target("avx2")))
+void kernel_avx2(float px, float py, float pdx, float pdy, const ChildTransforms & rules,
+                 float * x, float * y, float * dx, float * dy) {
+  const __m256 vpx { _mm256_set1_ps(px) };
+  const __m256 vpy { _mm256_set1_ps(py) };
+  const __m256 vpdx { _mm256_set1_ps(pdx) };
+  const __m256 vpdy { _mm256_set1_ps(pdy) };
+  long i { 0 };
+  for (; i + 8 <= cGroup; i += 8) {
+    const __m256 repos { _mm256_loadu_ps(&rules.repos[i]) };
+    const __m256 cs { _mm256_loadu_ps(&rules.cos_scale[i]) };
+    const __m256 sn { _mm256_loadu_ps(&rules.sin_scale[i]) };
+    _mm256_storeu_ps(x + i, _mm256_add_ps(vpx, _mm256_mul_ps(vpdx, repos)));
+    _mm256_storeu_ps(y + i, _mm256_add_ps(vpy, _mm256_mul_ps(vpdy, repos)));
+    _mm256_storeu_ps(dx + i, _mm256_sub_ps(_mm256_mul_ps(vpdx, cs), _mm256_mul_ps(vpdy, sn)));
+    _mm256_storeu_ps(dy + i, _mm256_add_ps(_mm256_mul_ps(vpdx, sn), _mm256_mul_ps(vpdy, cs)));
+  }
+  for (; i < cGroup; ++i) {
+    transform_child(i, px, py, pdx, pdy, rules, x, y, dx, dy);
+  }
+}
+#endif
+#endif
+
+#ifdef CHILD_KERNEL_NEON
+// NEON - 4 children per step (separate mul/add - same results as scalar)
+void kernel_neon(float px, float py, float pdx, float pdy, const ChildTransforms & rules,
+                 float * x, float * y, float * dx, float * dy) {
+  const float32x4_t vpx { vdupq_n_f32(px) };
+  const float32x4_t vpy { vdupq_n_f32(py) };
+  const float32x4_t vpdx { vdupq_n_f32(pdx) };
+  const float32x4_t vpdy { vdupq_n_f32(pdy) };
+  long i { 0 };
+  for (; i + 4 <= cGroup; i += 4) {
+    const float32x4_t repos { vld1q_f32(&rules.repos[i]) };
+    const float32x4_t cs { vld1q_f32(&rules.cos_scale[i]) };
+    const float32x4_t sn { vld1q_f32(&rules.sin_scale[i]) };
+    vst1q_f32(x + i, vaddq_f32(vpx, vmulq_f32(vpdx, repos)));
+    vst1q_f32(y + i, vaddq_f32(vpy, vmulq_f32(vpdy, repos)));
+    vst1q_f32(dx + i, vsubq_f32(vmulq_f32(vpdx, cs), vmulq_f32(vpdy, sn)));
+    vst1q_f32(dy + i, vaddq_f32(vmulq_f32(vpdx, sn), vmulq_f32(vpdy, cs)));
+  }
+  for (; i < cGroup; ++i) {
+    transform_child(i, px, py, pdx, pdy, rules, x, y, dx, dy);
+  }
+}
+#endif
+
+} // namespace
+
+
+bool ChildKernel::supported(Type type) {
+  switch (type) {
+  case scalar:
+    return true;
+#ifdef CHILD_KERNEL_X86
+  case sse:
+    return true;
+#ifdef CHILD_KERNEL_AVX2
+  case avx2:
+    return __builtin_cpu_supports("avx2");
+#endif
+#endif
+#ifdef CHILD_KERNEL_NEON
+  case neon:
+    return true;
+#endif
+  default:
+    return false;
+  }
+}
+
+
+ChildKernel ChildKernel::get(Type type) {
+  assert(supported(type) and "kernel not supported on this CPU");
+  switch (type) {
+#ifdef CHILD_KERNEL_X86
+  case sse:
+    return { type, kernel_sse };
+#ifdef CHILD_KERNEL_AVX2
+  case avx2:
+    return { type, kernel_avx2 };
+#endif
+#endif
+#ifdef CHILD_KERNEL_NEON
+  case neon:
+    return { type, kernel_neon };
+#endif
+  default:
+    return { scalar, kernel_scalar };
+  }
+}
+
+
+const char * ChildKernel::name(Type type) {
+  switch (type) {
+  case scalar: return "scalar";
+  case sse:    return "sse";
+  case avx2:   return "avx2";
+  case neon:   return "neon";
+  default:     return "unknown";
+  }
+}
+
+
+ChildKernel ChildKernel::select(const std::string & name) {
+  // Best supported - widest lanes first
+  Type best { scalar };
+  for (Type type : { avx2, sse, neon }) {
+    if (supported(type)) {
+      best = type;
+      break;
+    }
+  }
+
+  Type type { best };
+  if (name != "auto") {
+    int found { endOfTypes };
+    for (int t { scalar }; t < endOfTypes; ++t) {
+      if (name == ChildKernel::name(static_cast<Type>(t))) { found = t; }
+    }
+    if (found == endOfTypes) {
+      Dbg::report_warning("Unknown kernel (best supported used instead): " + name);
+    } else if (!supported(static_cast<Type>(found))) {
+      Dbg::report_warning("Kernel not supported by CPU (best supported used instead): " + name);
+    } else {
+      type = static_cast<Type>(found);
+    }
+  }
+  Dbg::report_info(std::string("Children transform kernel: ") + ChildKernel::name(type));
+  return get(type);
+}
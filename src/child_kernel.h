@@ -0,0 +1,38 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "fractal.h"
+#include <string>
+
+// Kernels transforming whole sibling group - all children of element
+// (DOWN branch then UP branch) - from their parent vector in one call.
+// Children columns x, y, dx, dy (e.g. of ElemStore page) are written.
+// Vectorized (SIMD) kernels compute exactly as scalar one - lanes are
+// just children, remaining ones are done by scalar code.
+// Kernel is selected at runtime (CPU features), also by CLI option.
+struct ChildKernel {
+  enum Type { scalar, sse, avx2, neon, endOfTypes };
+
+  using Fn = void (*)(float px, float py, float pdx, float pdy,
+                      const ChildTransforms & rules,
+                      float * x, float * y, float * dx, float * dy);
+
+  Type type;
+  Fn fn;
+
+  // Kernel by name: "auto" - best supported by CPU, or type name;
+  // unknown/unsupported one is reported and best supported used instead
+  static ChildKernel select(const std::string & name);
+  static ChildKernel get(Type type);
+  static bool supported(Type type);
+  static const char * name(Type type);
+};
@@ -15,10 +15,19 @@
 #include "assert.h"
 #include <SFML/Graphics/Color.hpp>
 #include <array>
+#include <cstdint>
 
 // Color definition in sf::Color:
 // Color(Uint8 red, Uint8 green, Uint8 blue, Uint8 alpha = 255);
 
+// Color between c0 (t = 0) and c1 (t = 1) - as gradient of stem is drawn
+inline sf::Color lerp_color(sf::Color c0, sf::Color c1, float t) {
+  auto mix = [t](std::uint8_t a, std::uint8_t b) {
+    return static_cast<std::uint8_t>(a + (b - a) * t + 0.5f);
+  };
+  return { mix(c0.r, c1.r), mix(c0.g, c1.g), mix(c0.b, c1.b), mix(c0.a, c1.a) };
+}
+
 struct StemColor {
   sf::Color begin_c;
   sf::Color end_c;
@@ -31,6 +40,16 @@ struct StemColor {
 // see getCircularColors();
 using T_Col_Palet = std::array<StemColor, cFrac::NrOfColorPaletes>;
 
+// Both palettes used for drawing stems (snapshot taken once per frame)
+struct StemPalettes {
+  T_Col_Palet normal;
+  T_Col_Palet flash;
+  // Colors for any order - reused in circular manner as getCircularColors()
+  const StemColor & colors(bool flashing, long order) const {
+    return (flashing ? flash : normal)[order % cFrac::NrOfColorPaletes];
+  }
+};
+
 struct ColorPal {
 
   // Diff algos for random palletes generation
@@ -71,6 +90,8 @@ struct ColorPal {
   
   // Helper function to obtain colors for any level event level exceeds Color Sets
   static StemColor getCircularColors(ColorType type, long int level);
+  // Current palettes (both)
+  static StemPalettes current_palettes() { return { s_col_palet, s_flash_col_palet }; }
 
 // called once in a display loop
 // to switch off possible global control flags
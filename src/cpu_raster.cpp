@@ -0,0 +1,298 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "cpu_raster.h"
+#include "colors.h"
+#include "dbg_report.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+CpuRaster::CpuRaster(sf::Vector2u size, int threads)
+  : m_size { size }
+  , m_tilesX { static_cast<int>((size.x + cTileSize -1) / cTileSize) }
+  , m_tilesY { static_cast<int>((size.y + cTileSize -1) / cTileSize) }
+  , m_pixels(std::size_t { size.x } * size.y * 4)
+  , m_pool { threads }
+  , m_chunks { static_cast<long>(m_pool.workers()) * cChunksPerThread }
+{
+  m_bins.resize(static_cast<std::size_t>(m_chunks) * m_tilesX * m_tilesY);
+  clear();
+  Dbg::report_info("CPU raster tiles: ", static_cast<long>(m_tilesX) * m_tilesY);
+}
+
+
+void CpuRaster::clear(sf::Color color) {
+  for (std::size_t i { 0 }; i < m_pixels.size(); i += 4) {
+    m_pixels[i] = color.r;
+    m_pixels[i +1] = color.g;
+    m_pixels[i +2] = color.b;
+    m_pixels[i +3] = color.a;
+  }
+}
+
+
+// Batches hold separate primitives only (no strips nor fans)
+static int vertices_per_primitive(sf::PrimitiveType type) {
+  switch (type) {
+  case sf::PrimitiveType::Triangles: return 3;
+  case sf::PrimitiveType::Lines: return 2;
+  case sf::PrimitiveType::Points: return 1;
+  default:
+    assert(false and "unsupported batch primitive");
+    return 1;
+  }
+}
+
+
+void CpuRaster::draw(const FrameBatches & batches) {
+  // Primitives in the same order as FrameBatches::flush
+  m_spans.clear();
+  m_prims = 0;
+  for (std::size_t type { 0 }; type < StemBatch::batchEndOfTypes; ++type) {
+    const int perPrim { vertices_per_primitive(StemBatch::cBatchPrimitives[type]) };
+    for (int part { 0 }; part < batches.parts(); ++part) {
+      const VertexArena & arena { batches.part(part).vertices(static_cast<StemBatch::BatchType>(type)) };
+      const long count { static_cast<long>(arena.size()) / perPrim };
+      if (count > 0) {
+        m_spans.push_back({arena.data(), count, perPrim});
+        m_prims += count;
+      }
+    }
+  }
+
+  auto bin = [this](long chunk, int) { bin_chunk(chunk); };
+  m_pool.run(m_chunks, bin);
+  auto tile = [this](long tile, int) { draw_tile(tile); };
+  m_pool.run(static_cast<long>(m_tilesX) * m_tilesY, tile);
+}
+
+
+// Assign primitives of chunk to bins of tiles they (bounding box) overlap
+void CpuRaster::bin_chunk(long chunk) {
+  const long tiles { static_cast<long>(m_tilesX) * m_tilesY };
+  std::vector<PrimRef> * bins { &m_bins[chunk * tiles] };
+  for (long tile { 0 }; tile < tiles; ++tile) {
+    bins[tile].clear();
+  }
+
+  const long first { m_prims * chunk / m_chunks };
+  const long last { m_prims * (chunk +1) / m_chunks };
+  long prim { 0 };
+  for (const Span & span : m_spans) {
+    const long begin { std::max(first, prim) - prim };
+    const long end { std::min(last, prim + span.count) - prim };
+    prim += span.count;
+    const long perPrim { span.perPrim };
+
+    for (long ind { begin }; ind < end; ++ind) {
+      const sf::Vertex * v { span.vertices + ind * perPrim };
+      float minX { v[0].position.x };
+      float maxX { minX };
+      float minY { v[0].position.y };
+      float maxY { minY };
+      for (long k { 1 }; k < perPrim; ++k) {
+        minX = std::min(minX, v[k].position.x);
+        maxX = std::max(maxX, v[k].position.x);
+        minY = std::min(minY, v[k].position.y);
+        maxY = std::max(maxY, v[k].position.y);
+      }
+      // anti-aliased lines reach one pixel around
+      minX -= 1;
+      minY -= 1;
+      maxX += 1;
+      maxY += 1;
+      if (maxX < 0 or maxY < 0 or minX >= m_size.x or minY >= m_size.y) {
+        continue; // outside of frame
+      }
+      const int tx0 { pixel_pos(minX, m_size.x) / cTileSize };
+      const int ty0 { pixel_pos(minY, m_size.y) / cTileSize };
+      const int tx1 { pixel_pos(maxX, m_size.x) / cTileSize };
+      const int ty1 { pixel_pos(maxY, m_size.y) / cTileSize };
+      for (int ty { ty0 }; ty <= ty1; ++ty) {
+        for (int tx { tx0 }; tx <= tx1; ++tx) {
+          bins[ty * m_tilesX + tx].push_back({v, span.perPrim});
+        }
+      }
+    }
+  }
+}
+
+
+// Pixel of coordinate limited to 0..size-1 (also far outside of frame)
+int CpuRaster::pixel_pos(float pos, unsigned size) {
+  return static_cast<int>(std::clamp(std::floor(pos), 0.0f, static_cast<float>(size -1)));
+}
+
+
+CpuRaster::Rect CpuRaster::tile_rect(long tile) const {
+  const int tx { static_cast<int>(tile % m_tilesX) };
+  const int ty { static_cast<int>(tile / m_tilesX) };
+  return { tx * cTileSize, ty * cTileSize,
+           std::min(static_cast<int>(m_size.x), (tx +1) * cTileSize),
+           std::min(static_cast<int>(m_size.y), (ty +1) * cTileSize) };
+}
+
+
+void CpuRaster::draw_tile(long tile) {
+  const long tiles { static_cast<long>(m_tilesX) * m_tilesY };
+  const Rect clip { tile_rect(tile) };
+  for (long chunk { 0 }; chunk < m_chunks; ++chunk) {
+    for (const PrimRef & prim : m_bins[chunk * tiles + tile]) {
+      if (prim.perPrim == 3) {
+        triangle(clip, prim.vertices);
+      } else if (prim.perPrim == 2) {
+        line(clip, prim.vertices);
+      } else {
+        point(clip, prim.vertices);
+      }
+    }
+  }
+}
+
+
+// Source over destination (as sf::BlendAlpha), source alpha scaled by coverage
+void CpuRaster::blend(int x, int y, sf::Color color, float coverage) {
+  std::uint8_t * dst { &m_pixels[(static_cast<std::size_t>(y) * m_size.x + x) * 4] };
+  const float a { coverage * color.a / 255.0f };
+  const float na { 1.0f - a };
+  dst[0] = static_cast<std::uint8_t>(color.r * a + dst[0] * na + 0.5f);
+  dst[1] = static_cast<std::uint8_t>(color.g * a + dst[1] * na + 0.5f);
+  dst[2] = static_cast<std::uint8_t>(color.b * a + dst[2] * na + 0.5f);
+  dst[3] = static_cast<std::uint8_t>(color.a * a + dst[3] * na + 0.5f);
+}
+
+
+// Filled triangle with colors interpolated between vertices;
+// pixel centers inside (top-left rule on edges) as OpenGL does
+void CpuRaster::triangle(const Rect & clip, const sf::Vertex * v) {
+  sf::Vector2f p0 { v[0].position };
+  sf::Vector2f p1 { v[1].position };
+  sf::Vector2f p2 { v[2].position };
+  sf::Color c1 { v[1].color };
+  sf::Color c2 { v[2].color };
+  float area { (p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x) };
+  if (area == 0.0f) { return; }
+  if (area < 0.0f) {
+    // counter-clockwise on screen - swap to keep edge functions positive
+    std::swap(p1, p2);
+    std::swap(c1, c2);
+    area = -area;
+  }
+
+  const int x0 { std::max(clip.x0, pixel_pos(std::min({p0.x, p1.x, p2.x}), m_size.x)) };
+  const int x1 { std::min(clip.x1 -1, pixel_pos(std::max({p0.x, p1.x, p2.x}), m_size.x)) };
+  const int y0 { std::max(clip.y0, pixel_pos(std::min({p0.y, p1.y, p2.y}), m_size.y)) };
+  const int y1 { std::min(clip.y1 -1, pixel_pos(std::max({p0.y, p1.y, p2.y}), m_size.y)) };
+
+  // Edge function of edge a->b for point p (positive inside)
+  auto edge = [](sf::Vector2f a, sf::Vector2f b, float px, float py) {
+    return (b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x);
+  };
+  // Top or left edge (pixel exactly on edge belongs to triangle)
+  auto topLeft = [](sf::Vector2f a, sf::Vector2f b) {
+    return (a.y == b.y and b.x < a.x) or (b.y < a.y);
+  };
+  const bool tl0 { topLeft(p1, p2) };
+  const bool tl1 { topLeft(p2, p0) };
+  const bool tl2 { topLeft(p0, p1) };
+
+  for (int y { y0 }; y <= y1; ++y) {
+    const float py { y + 0.5f };
+    for (int x { x0 }; x <= x1; ++x) {
+      const float px { x + 0.5f };
+      const float w0 { edge(p1, p2, px, py) };
+      const float w1 { edge(p2, p0, px, py) };
+      const float w2 { edge(p0, p1, px, py) };
+      if (w0 < 0 or w1 < 0 or w2 < 0) { continue; }
+      if ((w0 == 0 and !tl0) or (w1 == 0 and !tl1) or (w2 == 0 and !tl2)) { continue; }
+      const float b0 { w0 / area };
+      const float b1 { w1 / area };
+      const float b2 { w2 / area };
+      const sf::Color color {
+        static_cast<std::uint8_t>(v[0].color.r * b0 + c1.r * b1 + c2.r * b2 + 0.5f),
+        static_cast<std::uint8_t>(v[0].color.g * b0 + c1.g * b1 + c2.g * b2 + 0.5f),
+        static_cast<std::uint8_t>(v[0].color.b * b0 + c1.b * b1 + c2.b * b2 + 0.5f),
+        static_cast<std::uint8_t>(v[0].color.a * b0 + c1.a * b1 + c2.a * b2 + 0.5f) };
+      blend(x, y, color, 1.0f);
+    }
+  }
+}
+
+
+// Anti-aliased (Wu's algorithm) line with color gradient.
+// Stepping along major axis, every step covers two pixels across
+// proportionally to distance from line; line ends cover only their part.
+void CpuRaster::line(const Rect & clip, const sf::Vertex * v) {
+  float ax { v[0].position.x };
+  float ay { v[0].position.y };
+  float bx { v[1].position.x };
+  float by { v[1].position.y };
+  sf::Color ca { v[0].color };
+  sf::Color cb { v[1].color };
+
+  const bool steep { std::abs(by - ay) > std::abs(bx - ax) };
+  if (steep) {
+    std::swap(ax, ay);
+    std::swap(bx, by);
+  }
+  if (ax > bx) {
+    std::swap(ax, bx);
+    std::swap(ay, by);
+    std::swap(ca, cb);
+  }
+  const float length { bx - ax };
+  if (length <= 0.0f) { return; } // single point
+  const float gradient { (by - ay) / length };
+
+  // Major axis steps within clip
+  const int major0 { steep ? clip.y0 : clip.x0 };
+  const int major1 { steep ? clip.y1 : clip.x1 };
+  const int minor0 { steep ? clip.x0 : clip.y0 };
+  const int minor1 { steep ? clip.x1 : clip.y1 };
+  if (bx < major0 or ax >= major1) { return; }
+  const int first { std::max(major0, static_cast<int>(std::floor(std::max(ax, -1.0f)))) };
+  const int last { std::min(major1 -1, static_cast<int>(std::floor(std::min(bx, static_cast<float>(major1))))) };
+
+  for (int major { first }; major <= last; ++major) {
+    const float center { major + 0.5f };
+    // part of pixel covered by line (at line ends)
+    const float cover { std::min(bx, center + 0.5f) - std::max(ax, center - 0.5f) };
+    if (cover <= 0.0f) { continue; }
+    const float t { std::clamp((center - ax) / length, 0.0f, 1.0f) };
+    const sf::Color color { lerp_color(ca, cb, t) };
+
+    const float pos { ay + gradient * (center - ax) - 0.5f };
+    if (pos < minor0 -1 or pos >= minor1) { continue; }
+    const int minor { static_cast<int>(std::floor(pos)) };
+    const float frac { pos - minor };
+    const float coverage { std::min(cover, 1.0f) };
+    for (int k { 0 }; k < 2; ++k) {
+      const int m { minor + k };
+      if (m < minor0 or m >= minor1) { continue; }
+      const float weight { coverage * (k == 0 ? 1.0f - frac : frac) };
+      if (weight <= 0.0f) { continue; }
+      if (steep) {
+        blend(m, major, color, weight);
+      } else {
+        blend(major, m, color, weight);
+      }
+    }
+  }
+}
+
+
+// Single pixel the point lies in (as OpenGL point of size 1)
+void CpuRaster::point(const Rect & clip, const sf::Vertex * v) {
+  const float px { std::floor(v[0].position.x) };
+  const float py { std::floor(v[0].position.y) };
+  if (px < clip.x0 or px >= clip.x1 or py < clip.y0 or py >= clip.y1) { return; }
+  blend(static_cast<int>(px), static_cast<int>(py), v[0].color, 1.0f);
+}
@@ -0,0 +1,87 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "stem_batch.h"
+#include "thread_pool.h"
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+
+// Software (CPU) rasterizer of frame stems - no OpenGL context needed.
+// Draws the same batches as FrameBatches::flush (and in the same order):
+// gradient filled triangles, anti-aliased gradient lines and points,
+// alpha blended into RGBA framebuffer.
+// Frame is split into tiles rasterized in parallel by thread pool:
+//   1. binning - primitives (split into ordered chunks) are assigned
+//      to tiles they overlap, each chunk has its own bins
+//   2. tiles - each tile draws its bins chunk by chunk (draw order kept),
+//      pixels of tile are written by single thread only
+// Bins keep their storage between frames.
+struct CpuRaster {
+  // Tile size in pixels
+  constexpr static int cTileSize { 64 };
+  // # of binning chunks per thread
+  constexpr static int cChunksPerThread { 4 };
+
+  // threads - # of rasterizing threads (0 - all hardware threads)
+  CpuRaster(sf::Vector2u size, int threads);
+
+  void clear(sf::Color color = sf::Color::Black);
+  // Draw all batches (triangles of all parts first, then lines and points)
+  void draw(const FrameBatches & batches);
+
+  // RGBA pixels, row by row
+  const std::uint8_t * pixels() const { return m_pixels.data(); }
+  sf::Vector2u size() const { return m_size; }
+
+private:
+  // Primitive to be drawn - its first vertex
+  struct PrimRef {
+    const sf::Vertex * vertices;
+    int perPrim;  // # of vertices: 3 - triangle, 2 - line, 1 - point
+  };
+  // Consecutive primitives of single batch part
+  struct Span {
+    const sf::Vertex * vertices;
+    long count;   // # of primitives
+    int perPrim;
+  };
+  // Pixel rectangle [x0,x1) x [y0,y1)
+  struct Rect {
+    int x0, y0, x1, y1;
+  };
+
+  void bin_chunk(long chunk);
+  void draw_tile(long tile);
+  Rect tile_rect(long tile) const;
+  static int pixel_pos(float pos, unsigned size);
+
+  void triangle(const Rect & clip, const sf::Vertex * v);
+  void line(const Rect & clip, const sf::Vertex * v);
+  void point(const Rect & clip, const sf::Vertex * v);
+  void blend(int x, int y, sf::Color color, float coverage);
+
+  sf::Vector2u m_size;
+  int m_tilesX;
+  int m_tilesY;
+  std::vector<std::uint8_t> m_pixels;
+
+  ThreadPool m_pool;
+  // Primitives of current frame in draw order
+  std::vector<Span> m_spans;
+  long m_prims { 0 };
+  // bins[chunk * tiles + tile]
+  std::vector<std::vector<PrimRef>> m_bins;
+  long m_chunks;
+};
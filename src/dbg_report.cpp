@@ -7,18 +7,16 @@
 //
 // THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
+#include <cstdlib>
+#include <mutex>
+#include <new>
 #include <optional>
 #include <string>
 #include <iostream>
 #include "dbg_report.h"
 #include "garbage_coll.h"
 #include "fractal.h"
-
-// Garbage collector static variables
-unsigned long MemAndDebug::elementPtrsCnt; 
-// Collection of pointers ownership
-std::vector<std::unique_ptr<std::array<Element, cFrac::NrOfElements>>> 
-    MemAndDebug::allElementPtrs;
+#include "profiler.h"
 
 // Static Counters
 int Dbg::error_cnt {0}; 
@@ -26,12 +24,60 @@ long int Dbg::warning_cnt {0};
 long int Dbg::info_cnt {0}; 
 long int Dbg::elements {0};
 long int Dbg::m_demoCnt {0};
+std::atomic<long> Dbg::s_allocCnt {0};
+long Dbg::s_allocCntPrevFrame {0};
+long Dbg::s_allocFrames {0};
+long Dbg::s_missedDeadlines {0};
+
+std::mutex Dbg::s_reportMtx;
 
 std::chrono::time_point<Dbg::Clock> Dbg::time_beg;
 Dbg::VecMinMax Dbg::minmax;
 
+// Replacement of global allocation functions - counts every heap allocation.
+// Both plain and over-aligned (align_val_t) forms are replaced - array and
+// nothrow forms of new/delete default to them.
+void * operator new(std::size_t size) {
+  Dbg::count_allocation();
+  if (size == 0) { ++size; } // unique non-null pointer required
+  if (void * ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void * ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void * ptr, [[maybe_unused]] std::size_t size) noexcept {
+  std::free(ptr);
+}
+
+void * operator new(std::size_t size, std::align_val_t align) {
+  Dbg::count_allocation();
+  const std::size_t alignment { static_cast<std::size_t>(align) };
+  if (size == 0) { ++size; } // unique non-null pointer required
+  // size shall be multiple of alignment
+  size = (size + alignment - 1) / alignment * alignment;
+  if (void * ptr = std::aligned_alloc(alignment, size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void * ptr, [[maybe_unused]] std::align_val_t align) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void * ptr, [[maybe_unused]] std::size_t size,
+                     [[maybe_unused]] std::align_val_t align) noexcept {
+  std::free(ptr);
+}
+
 
 void Dbg::report_info(std::string_view s, std::optional<long> i) {
+  std::lock_guard<std::mutex> lock { s_reportMtx };
   if(cReportInfo) {
     std::cerr << "  Info: "<< s;
     if (i) {
@@ -55,6 +101,7 @@ void Dbg::report_trace(std::string_view s, std::optional<long> i) {
 }
 
 void Dbg::report_warning(std::string_view s, std::optional<long> i) {
+  std::lock_guard<std::mutex> lock { s_reportMtx };
   if(cReportWarning) {
     std::cerr << " Warning: "<< s;
     if (i) {
@@ -66,6 +113,7 @@ void Dbg::report_warning(std::string_view s, std::optional<long> i) {
 }
 
 void Dbg::report_error(std::string s, long int i) {
+  std::lock_guard<std::mutex> lock { s_reportMtx };
   if(cReportError) {
     std::cerr << "! ERROR: "<< s << i << '\n'; 
   }
@@ -76,10 +124,10 @@ void Dbg::report_error(std::string s, long int i) {
 }
 
 void Dbg::report_mltpl_warning(Dbg::MultipleWarning mwtype, long int counter) {
+  std::lock_guard<std::mutex> lock { s_reportMtx };
   if(cReportWarning) {
     static long mwCreate { cCreateWarningThreshold };
     static long mwDraw { cDrawWarningThreshold };
-    static long mwPointer { cCreatePointersThreshold };
 
     if ((mltplElementsCreate == mwtype) and (counter >= mwCreate)) {
       std::cerr << " Warning: Too much Elements created: >" << counter << '\n';
@@ -92,12 +140,7 @@ void Dbg::report_mltpl_warning(Dbg::MultipleWarning mwtype, long int counter) {
       mwDraw *= 2; // double threshold for next time
       ++warning_cnt; 
     }
-    
-    if ((mltplPointers == mwtype) and (counter >= mwPointer)) {
-      std::cerr << " Warning: Too much Smart Pointers collected: >" << counter << '\n';
-      mwPointer *= 2; // double threshold for next time
-      ++warning_cnt; 
-    }
+
   } else {
     static bool already_warned { false };
     // increment counter by one if no Report Warning option is chosen
@@ -112,6 +155,9 @@ void Dbg::report_info_by_type( InfoMsgByType type, long current) {
   // lates data
   static long ibtDrawnPrevious {};
   static long ibtTimePrevious {};
+  static long ibtAllocPrevious {};
+  static long ibtCulledPrevious {};
+  static long ibtMissedPrevious {};
 
 
   if (infoTypeElementsDrawnPerCycle == type) {
@@ -141,6 +187,50 @@ void Dbg::report_info_by_type( InfoMsgByType type, long current) {
       theSameCounter = 0;
       report_info("Time per frame (ms): ", current); 
     }
+  }
+  else if (infoTypeAllocationsPerFrame == type) {
+    static long theSameCounter {};
+    if (Dbg::isWithinTenPercent(ibtAllocPrevious, current)) {
+      ++theSameCounter;
+      if (cReportInfo and (theSameCounter < 2)) {
+        std::cerr << "        ... \n";
+      }
+    } else {
+      // Really diffrent value
+      ibtAllocPrevious = current;
+      theSameCounter = 0;
+      report_info("Heap allocations per frame: ", current); 
+    }
+  }
+  else if (infoTypeSubtreesCulledPerCycle == type) {
+    static long theSameCounter {};
+    if (Dbg::isWithinTenPercent(ibtCulledPrevious, current)) {
+      ++theSameCounter;
+      if (cReportInfo and (theSameCounter < 2)) {
+        std::cerr << "        ... \n";
+      }
+    } else {
+      // Really diffrent value
+      ibtCulledPrevious = current;
+      theSameCounter = 0;
+      report_info("Subtrees culled (off-screen) per cycle: ", current); 
+    }
+  }
+  else if (infoTypeMissedDeadlines == type) {
+    // total # so far - kept for summary
+    s_missedDeadlines = current;
+    static long theSameCounter {};
+    if (Dbg::isWithinTenPercent(ibtMissedPrevious, current)) {
+      ++theSameCounter;
+      if (cReportInfo and (theSameCounter < 2)) {
+        std::cerr << "        ... \n";
+      }
+    } else {
+      // Really diffrent value
+      ibtMissedPrevious = current;
+      theSameCounter = 0;
+      report_info("Missed frame deadlines: ", current); 
+    }
   } else {
     assert(false and "Unexpected else");
   }
@@ -167,6 +257,17 @@ void Dbg::count_elements(int i) {
   }
 }
 
+// # of heap allocations since previous call - called once per frame
+long Dbg::frame_allocations() {
+  long all_allocs { s_allocCnt.load(std::memory_order_relaxed) };
+  long frame_allocs { all_allocs - s_allocCntPrevFrame };
+  s_allocCntPrevFrame = all_allocs;
+  if (frame_allocs > 0) {
+    ++s_allocFrames;
+  }
+  return frame_allocs;
+}
+
 void Dbg::demo_frames(long int cnt) {
   if (cnt > m_demoCnt) m_demoCnt = cnt;
 }
@@ -189,6 +290,12 @@ void Dbg::report_summary(void) noexcept {
   std::cout << "Min/Max /   "<< minmax.minY  << "   \\ \n"; 
   std::cout << "Min/Max |"<< minmax.minX << "  " << minmax.maxX << "| \n"; 
   std::cout << "Min/Max \\   "<< minmax.maxY  << "  / \n"; 
+  std::cout << "Element arena used (peak): " << MemAndDebug::elem_arena().bytes_peak() 
+            << " of reserved: " << MemAndDebug::elem_arena().bytes_reserved() << " bytes\n";
+  std::cout << "Total # of Heap allocations: "<< s_allocCnt.load() 
+            << " (frames with allocations: " << s_allocFrames << ")\n"; 
+  std::cout << "Total # of Missed frame deadlines: "<< s_missedDeadlines << '\n'; 
+  FrameProfile::report_summary();
   std::cout << "Total # of Warnings: "<< warning_cnt << '\n'; 
   std::cout << "Total # of ERRORS: "<< error_cnt << '\n'; 
   }
@@ -9,8 +9,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <chrono>
+#include <mutex>
 #include <string_view>
 #include <optional>
 
@@ -63,13 +65,13 @@ struct Dbg
   // Start multiple warnings thresholds
   // Too much elements created
   constexpr static long cCreateWarningThreshold { 2'000'000 };
-  // Too much pointers created
-  constexpr static long cCreatePointersThreshold { 10'000'000 };
   // Too much elements drawed per cycle (frame)
   constexpr static long cDrawWarningThreshold { 5'000'000 };
 
-  enum MultipleWarning { mltplElementsCreate, mltplElementsDraw, mltplPointers };
-  enum InfoMsgByType { infoTypeElementsDrawnPerCycle, infoTypeTimePerFrame };
+  enum MultipleWarning { mltplElementsCreate, mltplElementsDraw };
+  enum InfoMsgByType { infoTypeElementsDrawnPerCycle, infoTypeTimePerFrame,
+                       infoTypeAllocationsPerFrame, infoTypeSubtreesCulledPerCycle,
+                       infoTypeMissedDeadlines };
 
   static void count_elements(int i);
   static void demo_frames(long int i);
@@ -85,6 +87,17 @@ struct Dbg
   static void find_minmax(const VecMinMax minmaxVec);
   static void report_summary(void) noexcept;
 
+  // Heap allocations counting (global operator new is counting them)
+  static void count_allocation() noexcept {
+    s_allocCnt.fetch_add(1, std::memory_order_relaxed);
+  }
+  // # of heap allocations since previous call - called once per frame
+  static long frame_allocations();
+  // # of all heap allocations so far
+  static long allocations() {
+    return s_allocCnt.load(std::memory_order_relaxed);
+  }
+
   private:
 
   // Exit after # of errors
@@ -101,7 +114,18 @@ struct Dbg
   static long int info_cnt; 
   static long int elements;
   static long int m_demoCnt;
+
+  // Heap allocations: all and counted up to previous frame
+  static std::atomic<long> s_allocCnt;
+  static long s_allocCntPrevFrame;
+  // # of frames with any heap allocation (expected to stop growing after warm-up)
+  static long s_allocFrames;
+  // # of frames started after their deadline (see scheduler.h)
+  static long s_missedDeadlines;
   
+  // Reports can come also from walking (worker) threads
+  static std::mutex s_reportMtx;
+
   // timer
   // using Clock = std::chrono::steady_clock;
   using Clock = std::chrono::high_resolution_clock;
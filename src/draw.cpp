@@ -12,15 +12,20 @@
 #include "light.h"
 #include "transform.h"
 #include "colors.h"
+#include "stem_batch.h"
 #include "assert.h"
 #include <SFML/Graphics.hpp>
 #include <SFML/Graphics/Color.hpp>
-#include <SFML/Graphics/PrimitiveType.hpp>
-#include <SFML/Graphics/Vertex.hpp>
-#include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/System/Vector2.hpp>
 
-void StemFlash::draw_stem(sf::RenderWindow &win, long order, const bool freezeTime) {
+FlashCtrl FlashCtrl::current(bool freezeTime) {
+  return { ColorPal::s_global_flash, ColorPal::s_reset_flash_algo,
+           LightS::s_lightActive, LightS::s_lightVec, freezeTime };
+}
+
+
+// Single frame step of flash effect - shared by every stem
+bool FlashState::step(float dx, float dy, const FlashCtrl & ctrl) {
 
   // effect lasting # of frames
   constexpr static unsigned int FLASH_GLOBAL_CNT_MAX { 5 };
@@ -28,121 +33,84 @@ void StemFlash::draw_stem(sf::RenderWindow &win, long order, const bool freezeTi
   constexpr static unsigned int FLASH_LIGHT_CNT_MAX { 10 };
 
   // 90 deg transition vec / light vec
-  if (light_vec_angle_flip()) {
+  if (light_vec_angle_flip(dx, dy, ctrl.lightVec)) {
     // show local (this stem) flash
     flash_cnt = FLASH_LIGHT_CNT_MAX;
   }
   
   // Further comtrol of flash effect 
-  if (ColorPal::s_global_flash) {
+  if (ctrl.globalFlash) {
     // Flash with all stems
     flash_cnt = FLASH_GLOBAL_CNT_MAX;
-  } else if (ColorPal::s_reset_flash_algo) {
+  } else if (ctrl.resetFlash) {
     prev_l_angle = lAngleUnknown;
     flash_cnt = 0;
   // Time freeze option (stop type)
-  } else if ((this->flash_cnt > 0) and (!freezeTime)) {
+  } else if ((this->flash_cnt > 0) and (!ctrl.freezeTime)) {
     // keep flash effect for some time
     --flash_cnt;
   } else { }
-  
+
+  return (flash_cnt > 0 and ctrl.lightActive);
+}
+
+
+void StemFlash::draw_stem(StemBatch &batch, long order, const bool freezeTime) {
+  const bool flashing { flash.step(vec_xy.dx, vec_xy.dy, FlashCtrl::current(freezeTime)) };
+  const ThickPoints thick { x1, y1, x2, y2 };
+  batch.append_stem(order, flashing, vec_xy.x, vec_xy.y, vec_xy.dx, vec_xy.dy, thick,
+                    ColorPal::current_palettes());
+}
+
+
+// Stem vertices - in ordinary or Flash version
+void StemBatch::append_stem(long order, bool flashing, float x, float y, float dx, float dy,
+                            const ThickPoints & thick, const StemPalettes & palettes) {
   assert(order >= 0);
   assert(order <= cFrac::NrOfOrders +1);
   
   if (order <= 2) {
-    if (x1==0 or x2==0 or y1==0 or y2==0) {
-      Dbg::report_warning(" Suspected (0) stem data coordinate(s), possible not initialized ", x1);
+    if (thick.x1==0 or thick.x2==0 or thick.y1==0 or thick.y2==0) {
+      Dbg::report_warning(" Suspected (0) stem data coordinate(s), possible not initialized ", thick.x1);
     } else {
-      float fvdx = (vec_xy.x + vec_xy.dx);
-      float fvdy = (vec_xy.y + vec_xy.dy);
+      sf::Vector2f top {x + dx, y + dy};
       
-      if (flash_cnt > 0 and LightS::s_lightActive) {
+      if (flashing) {
         // Draw Flash version
 
-        // Filled triangles
-        sf::VertexArray triangle(sf::PrimitiveType::Triangles, 3);
-        triangle[0].position = sf::Vector2f(x1,y1);
-        triangle[1].position = sf::Vector2f(fvdx, fvdy);
-        triangle[2].position = sf::Vector2f(x2,y2);
-
-        // Flash colors
-        triangle[0].color = ColorPal::
-          getCircularColors(ColorPal::flashColors, order).begin_c;
-        triangle[2].color = ColorPal::
-          getCircularColors(ColorPal::flashColors, order).begin_c;
-        triangle[1].color = ColorPal::
-          getCircularColors(ColorPal::flashColors, order).end_c;
-        
-        win.draw(triangle);
+        // Filled triangles in Flash colors
+        const StemColor & colors { palettes.colors(flashing, order) };
+        append_triangle({thick.x1, thick.y1}, top, {thick.x2, thick.y2},
+                        colors.begin_c, colors.end_c);
       } else {
         // Draw ordinary version
 
-        // Empty triangles
-        sf::VertexArray two_lines(sf::PrimitiveType::Lines, 4);
-        two_lines[0].position = sf::Vector2f(x1,y1);
-        two_lines[1].position = sf::Vector2f(fvdx, fvdy);
-        two_lines[2].position = sf::Vector2f(x2,y2);
-        two_lines[3].position = sf::Vector2f(fvdx, fvdy);
-        // Regular colors
-        two_lines[0].color = ColorPal::
-          getCircularColors(ColorPal::normalColors, order).begin_c;
-        two_lines[2].color = ColorPal::
-          getCircularColors(ColorPal::normalColors, order).begin_c;
-        two_lines[1].color = ColorPal::
-          getCircularColors(ColorPal::normalColors, order).end_c;
-        two_lines[3].color = ColorPal::
-          getCircularColors(ColorPal::normalColors, order).end_c;
-
-        win.draw(two_lines);
+        // Empty triangles in Regular colors
+        const StemColor & colors { palettes.colors(flashing, order) };
+        append_line(batchLines, {thick.x1, thick.y1}, top, colors.begin_c, colors.end_c);
+        append_line(batchLines, {thick.x2, thick.y2}, top, colors.begin_c, colors.end_c);
       }
 
     }
     
   } else { // order > 2
-    float fvx = vec_xy.x;
-    float fvy = vec_xy.y;
-    float fvdx = (vec_xy.x + vec_xy.dx);
-    float fvdy = (vec_xy.y + vec_xy.dy);
+    float fvx = x;
+    float fvy = y;
+    float fvdx = (x + dx);
+    float fvdy = (y + dy);
 
-    if (flash_cnt > 0 and LightS::s_lightActive) {
+    if (flashing) {
       // Draw Flash version
-      // Double/Triple line thickness
-      sf::VertexArray tri_line(sf::PrimitiveType::Lines, 6);
-      tri_line[0].position = sf::Vector2f(fvx,fvy);
-      tri_line[1].position = sf::Vector2f(fvdx, fvdy);
-      tri_line[2].position = sf::Vector2f(fvx +1,fvy);
-      tri_line[3].position = sf::Vector2f(fvdx +1, fvdy);
-      tri_line[4].position = sf::Vector2f(fvx,fvy +1);
-      tri_line[5].position = sf::Vector2f(fvdx, fvdy +1);
-
-      // Flash colors
-      tri_line[0].color = ColorPal::
-          getCircularColors(ColorPal::flashColors, order).begin_c;
-      tri_line[1].color = ColorPal::
-          getCircularColors(ColorPal::flashColors, order).end_c;
-      tri_line[2].color = ColorPal::
-          getCircularColors(ColorPal::flashColors, order).begin_c;
-      tri_line[3].color = ColorPal::
-          getCircularColors(ColorPal::flashColors, order).end_c;
-      tri_line[4].color = ColorPal::
-          getCircularColors(ColorPal::flashColors, order).begin_c;
-      tri_line[5].color = ColorPal::
-          getCircularColors(ColorPal::flashColors, order).end_c;
-
-      win.draw(tri_line);
+      // Double/Triple line thickness in Flash colors
+      const StemColor & colors { palettes.colors(flashing, order) };
+      append_line(batchFlashLines, {fvx, fvy}, {fvdx, fvdy}, colors.begin_c, colors.end_c);
+      append_line(batchFlashLines, {fvx +1, fvy}, {fvdx +1, fvdy}, colors.begin_c, colors.end_c);
+      append_line(batchFlashLines, {fvx, fvy +1}, {fvdx, fvdy +1}, colors.begin_c, colors.end_c);
     } else {
       // Draw ordinary version
-      // Single line
-      sf::VertexArray one_line(sf::PrimitiveType::Lines, 2);
-      one_line[0].position = sf::Vector2f(fvx,fvy);
-      one_line[1].position = sf::Vector2f(fvdx, fvdy);
-      // Regular colors
-      one_line[0].color = ColorPal::
-          getCircularColors(ColorPal::normalColors, order).begin_c;
-      one_line[1].color = ColorPal::
-          getCircularColors(ColorPal::normalColors, order).end_c;
-
-      win.draw(one_line);
+      // Single line in Regular colors
+      const StemColor & colors { palettes.colors(flashing, order) };
+      append_line(batchLines, {fvx, fvy}, {fvdx, fvdy}, colors.begin_c, colors.end_c);
     }
   }
 
@@ -150,7 +118,7 @@ void StemFlash::draw_stem(sf::RenderWindow &win, long order, const bool freezeTi
 
 // Old draw - without light flash
 [[deprecated("use StemFlash::draw_step instead")]] 
-void Stem::draw_stem(sf::RenderWindow &win, long order,
+void Stem::draw_stem(StemBatch &batch, long order,
                      [[maybe_unused]]const bool freezeTime) {
   
   assert(order >= 0);
@@ -159,19 +127,11 @@ void Stem::draw_stem(sf::RenderWindow &win, long order,
     if (x1==0 or x2==0 or y1==0 or y2==0) {
       Dbg::report_warning(" Suspected (0) stem data coordinate(s), possible not initialized ", x1);
     } else {
-      float fvdx = (vec_xy.x + vec_xy.dx);
-      float fvdy = (vec_xy.y + vec_xy.dy);
-      sf::VertexArray two_lines(sf::PrimitiveType::Lines, 4);
-      two_lines[0].position = sf::Vector2f(x1,y1);
-      two_lines[1].position = sf::Vector2f(fvdx, fvdy);
-      two_lines[2].position = sf::Vector2f(x2,y2);
-      two_lines[3].position = sf::Vector2f(fvdx, fvdy);
-
-      two_lines[0].color = ColorPal::s_col_palet[order].begin_c;
-      two_lines[2].color = ColorPal::s_col_palet[order].begin_c;
-      two_lines[1].color = ColorPal::s_col_palet[order].end_c;
-      two_lines[3].color = ColorPal::s_col_palet[order].end_c;
-      win.draw(two_lines);
+      sf::Vector2f top {vec_xy.x + vec_xy.dx, vec_xy.y + vec_xy.dy};
+      batch.append_line(StemBatch::batchLines, {x1,y1}, top,
+                        ColorPal::s_col_palet[order].begin_c, ColorPal::s_col_palet[order].end_c);
+      batch.append_line(StemBatch::batchLines, {x2,y2}, top,
+                        ColorPal::s_col_palet[order].begin_c, ColorPal::s_col_palet[order].end_c);
     }
     
   } else { // order > 2
@@ -179,11 +139,7 @@ void Stem::draw_stem(sf::RenderWindow &win, long order,
     float fvy = vec_xy.y;
     float fvdx = (vec_xy.x + vec_xy.dx);
     float fvdy = (vec_xy.y + vec_xy.dy);
-    sf::VertexArray one_line(sf::PrimitiveType::Lines, 2);
-    one_line[0].position = sf::Vector2f(fvx,fvy);
-    one_line[1].position = sf::Vector2f(fvdx, fvdy);
-    one_line[0].color = ColorPal::s_col_palet[order].begin_c;
-    one_line[1].color = ColorPal::s_col_palet[order].end_c;
-    win.draw(one_line);
+    batch.append_line(StemBatch::batchLines, {fvx, fvy}, {fvdx, fvdy},
+                      ColorPal::s_col_palet[order].begin_c, ColorPal::s_col_palet[order].end_c);
   }
 }
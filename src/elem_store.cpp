@@ -0,0 +1,187 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "elem_store.h"
+#include "dbg_report.h"
+#include "garbage_coll.h"
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <new>
+
+ElemStore::ElemStore(long memBudgetMB, ChildKernel kernel)
+  : m_budgetBytes { static_cast<std::size_t>(std::max(memBudgetMB, 0L)) * 1024 * 1024 }
+  , m_kernel { kernel }
+{
+  // Page tables for every possible slot of every order
+  long slots { 1 };
+  for (long order { 0 }; order <= cFrac::NrOfOrders; ++order) {
+    m_levels[order].pages = std::vector<std::atomic<Page *>>((slots + cPageSlots -1) / cPageSlots);
+    if (order <= cThickOrders) {
+      m_levels[order].thick.resize(slots);
+    }
+    slots *= cChildren;
+  }
+  Dbg::report_info("Element size (bytes per stored element): ",
+                   static_cast<long>(sizeof(Page) / cPageSlots));
+}
+
+
+void ElemStore::reset() {
+  for (auto & lv : m_levels) {
+    std::fill(lv.pages.begin(), lv.pages.end(), nullptr);
+  }
+  m_pagesCnt = 0;
+  m_allocated.clear();
+  MemAndDebug::elem_arena().reset();
+}
+
+
+void ElemStore::load_primary(Element & prim, const T_Fluctuate_Algo_Arr & algo_fluct_data) {
+  // Primary (possible 'growing') transformation is done on Element itself
+  // as autoscale relies on it
+  prim.transform_vec_stem(algo_fluct_data);
+
+  ++m_frame;
+  Level & lv { m_levels[0] };
+  Page * const pg_ptr { lv.pages[0].load(std::memory_order_relaxed) };
+  Page & pg { pg_ptr ? *pg_ptr : allocate_page(0, 0) };
+  pg.lastVisit.store(m_frame, std::memory_order_relaxed);
+  const StemFlash & stem { prim.stem_xy };
+  pg.x[0] = stem.vec_xy.x;
+  pg.y[0] = stem.vec_xy.y;
+  pg.dx[0] = stem.vec_xy.dx;
+  pg.dy[0] = stem.vec_xy.dy;
+  pg.flash[0] = stem.flash;
+  lv.thick[0] = { stem.x1, stem.y1, stem.x2, stem.y2 };
+}
+
+void ElemStore::save_primary(Element & prim) const {
+  prim.stem_xy.flash = m_levels[0].pages[0].load(std::memory_order_relaxed)->flash[0];
+}
+
+
+ElemStore::Page * ElemStore::children_page(long order, long slot) {
+  if (order +1 > cFrac::NrOfOrders) {
+    return nullptr; // Stop further branches
+  }
+  const long page_ind { first_child(slot) / cPageSlots };
+  Page * pg { m_levels[order +1].pages[page_ind].load(std::memory_order_acquire) };
+  if (pg == nullptr) {
+    pg = &allocate_page(order +1, page_ind);
+  }
+  // same value from every walking thread
+  pg->lastVisit.store(m_frame, std::memory_order_relaxed);
+  return pg;
+}
+
+
+// Allocate subordinate elements/branches - page of all columns
+ElemStore::Page & ElemStore::allocate_page(long order, long page_ind) {
+  std::lock_guard<std::mutex> lock { m_allocMtx };
+  auto & page_ptr { m_levels[order].pages[page_ind] };
+  if (Page * const pg = page_ptr.load(std::memory_order_acquire)) {
+    return *pg;  // meanwhile allocated by other thread
+  }
+  Page * const pg { new (MemAndDebug::elem_arena().allocate()) Page {} };
+  page_ptr.store(pg, std::memory_order_release);
+  ++m_pagesCnt;
+  m_allocated.push_back({order, page_ind});
+  Dbg::count_elements(cPageSlots);
+
+  // Warn if too much elemnts created
+  if (m_pagesCnt * cPageSlots >= Dbg::cCreateWarningThreshold) {
+    Dbg::report_mltpl_warning(Dbg::mltplElementsCreate, m_pagesCnt * cPageSlots);
+  }
+  return *pg;
+}
+
+
+void ElemStore::reclaim() {
+  long released { 0 };
+  if (m_frame % cReclaimPeriod == 0) {
+    released += release_older_than(cReclaimAge);
+  }
+
+  // Over budget - release also more recently used pages
+  const SlabArena & arena { MemAndDebug::elem_arena() };
+  long age { cReclaimAge };
+  while (m_budgetBytes > 0 and arena.bytes_used() > m_budgetBytes and age > 0) {
+    age /= 2;
+    released += release_older_than(age);
+  }
+  if (m_budgetBytes > 0 and arena.bytes_used() > m_budgetBytes and !m_budgetWarned) {
+    // Pages of current frame are never released
+    m_budgetWarned = true;
+    Dbg::report_warning("Memory budget too small for current drawing (bytes used): ",
+                        static_cast<long>(arena.bytes_used()));
+  }
+
+  if (released > 0) {
+    Dbg::report_info("Element pages released (unused): ", released);
+  }
+}
+
+
+long ElemStore::release_older_than(long age) {
+  long released { 0 };
+  for (std::size_t ind { 0 }; ind < m_allocated.size(); ) {
+    const PageId id { m_allocated[ind] };
+    auto & page_ptr { m_levels[id.order].pages[id.page_ind] };
+    Page * const pg { page_ptr.load(std::memory_order_relaxed) };
+    if (m_frame - pg->lastVisit.load(std::memory_order_relaxed) > age) {
+      // Subtrees of page elements not visited either - their pages
+      // are released by the same scan
+      MemAndDebug::elem_arena().release(pg);
+      page_ptr.store(nullptr, std::memory_order_relaxed);
+      --m_pagesCnt;
+      ++released;
+      // unordered removal
+      m_allocated[ind] = m_allocated.back();
+      m_allocated.pop_back();
+    } else {
+      ++ind;
+    }
+  }
+  return released;
+}
+
+
+// Tranform parent vector (also stem data) to all its children
+// considering index and branch type (position within children)
+void ElemStore::transform_children(long order, long slot,
+                                   const T_Child_Transform_Arr & child_transforms) {
+  const Page & par { page(order, slot) };
+  const long p { slot % cPageSlots };
+  const long first { first_child(slot) };
+  Page & chl { page(order +1, first) };
+  const long c { first % cPageSlots };
+
+  const ChildTransforms & rules { child_transforms[order +1] };
+  const float px { par.x[p] };
+  const float py { par.y[p] };
+  const float pdx { par.dx[p] };
+  const float pdy { par.dy[p] };
+
+  // stem width only for first orders
+  if (order +1 <= cThickOrders) {
+    const float thickness { (order +1 == 1) ? Stem::cThick2Fraction : Stem::cThick1Fraction };
+    for (long ind { 0 }; ind < cChildren; ++ind) {
+      const float fraction { rules.repos[ind] };
+      m_levels[order +1].thick[first + ind] = {
+        px + pdx * (fraction - thickness), py + pdy * (fraction - thickness),
+        px + pdx * (fraction + thickness), py + pdy * (fraction + thickness) };
+    }
+  }
+
+  // Central Line transformation, rotate and scale - whole sibling group
+  m_kernel.fn(px, py, pdx, pdy, rules,
+              &chl.x[c], &chl.y[c], &chl.dx[c], &chl.dy[c]);
+}
@@ -0,0 +1,153 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "child_kernel.h"
+#include "fractal.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+// Structure-of-arrays storage of fractal elements (tree nodes).
+// Tree has fixed shape (2*NrOfElements children per element) thus it is
+// indexed implicitly - no links are stored:
+//   slot of element within its order: 0 .. (2*NrOfElements)^order -1
+//   children of slot s: s*cChildren .. s*cChildren + cChildren-1 (next order)
+//   - DOWN branch elements 1..NrOfElements first, then UP branch ones
+//   parent of slot s: s / cChildren (previous order)
+// Every order keeps its columns (vector x/y/dx/dy and flash light state)
+// in fixed size pages allocated only when some of its elements are needed
+// (from arena of MemAndDebug - all released at once by reset).
+// Pages not visited for cReclaimAge frames are released (subtrees pruned)
+// and recreated when needed again; optional memory budget makes it earlier.
+// Stem thickness points are kept only for orders <= cThickOrders.
+// Primary element (order 0) is loaded from its Element view every frame.
+// Elements can be walked by many threads (disjoint subtrees) at once -
+// children_page and transform_children are thread safe for them.
+struct ElemStore {
+  // # of children of single element (both branches)
+  constexpr static long cChildren { 2 * cFrac::NrOfElements };
+  // Highest order with stored stem thickness points
+  constexpr static long cThickOrders { 2 };
+  // # of element slots per page - multiply of cChildren
+  // so children of an element never cross pages
+  constexpr static long cPageSlots { 10 * cChildren };
+  static_assert(cPageSlots % cChildren == 0);
+
+  // Columns of cPageSlots elements of one order
+  struct Page {
+    std::array<float, cPageSlots> x;
+    std::array<float, cPageSlots> y;
+    std::array<float, cPageSlots> dx;
+    std::array<float, cPageSlots> dy;
+    std::array<FlashState, cPageSlots> flash; // initially angle unknown, no flash
+    std::atomic<long> lastVisit;  // frame # of last visit of any element of page
+  };
+  // Pages are never destructed - just dropped by arena reset
+  static_assert(std::is_trivially_destructible_v<Page>);
+
+  // Pages of single order (page table is allocated up front);
+  // page pointers are published to other walking threads atomically
+  struct Level {
+    std::vector<std::atomic<Page *>> pages;
+    std::vector<ThickPoints> thick; // orders <= cThickOrders only
+  };
+
+  // Unused pages are released after # of frames
+  constexpr static long cReclaimAge { 300 };
+  // Check for unused pages every # of frames
+  constexpr static long cReclaimPeriod { 60 };
+
+  // memBudgetMB - elements memory limit in MB (0 - no limit)
+  // kernel - children transformation (see child_kernel.h)
+  explicit ElemStore(long memBudgetMB = 0,
+                     ChildKernel kernel = ChildKernel::get(ChildKernel::scalar));
+
+  // Implicit tree relations
+  static long first_child(long slot) { return slot * cChildren; }
+  static long parent(long slot) { return slot / cChildren; }
+  static BranchType branch(long slot) {
+    return (slot % cChildren < cFrac::NrOfElements) ? downBranch : upBranch;
+  }
+  // 1..NrOfElements
+  static long index(long slot) { return slot % cFrac::NrOfElements + 1; }
+
+  // Transform primary element (its Element view) and copy it as order 0
+  void load_primary(Element & prim, const T_Fluctuate_Algo_Arr & algo_fluct_data);
+  // Flash state of primary element is kept in its Element view
+  void save_primary(Element & prim) const;
+
+  // Drop all elements (but primary one kept in Element view);
+  // they are recreated from scratch on next walk
+  void reset();
+
+  // Release pages not visited recently (or over memory budget) - once per frame
+  void reclaim();
+  // Release every page not visited by the last walk (e.g. outside
+  // of visible area) - returns # of released pages
+  long reclaim_unvisited() { return release_older_than(0); }
+
+  // Page holding children of given element - allocated if needed;
+  // nullptr if no more orders are allowed
+  Page * children_page(long order, long slot);
+
+  // Transform all children of given element from (parent) element vector
+  void transform_children(long order, long slot, const T_Child_Transform_Arr & child_transforms);
+
+  // Page of existing element
+  Page & page(long order, long slot) {
+    return *m_levels[order].pages[slot / cPageSlots].load(std::memory_order_acquire);
+  }
+
+  // Thickness points of element (or cNoThick for higher orders)
+  const ThickPoints & thick(long order, long slot) const {
+    return (order <= cThickOrders) ? m_levels[order].thick[slot] : cNoThick;
+  }
+
+  // # of allocated pages
+  long pages() const { return m_pagesCnt; }
+
+private:
+  // Stem of order without thickness points
+  constexpr static ThickPoints cNoThick {};
+
+  Page & allocate_page(long order, long page_ind);
+  // Release pages not visited for more than given # of frames
+  long release_older_than(long age);
+
+  struct PageId {
+    long order;
+    long page_ind;
+  };
+
+  std::array<Level, cFrac::NrOfOrders +1> m_levels;
+  // Pages can be allocated by many walking threads
+  std::mutex m_allocMtx;
+  long m_pagesCnt { 0 };
+  // Allocated pages (scanned by reclaim)
+  std::vector<PageId> m_allocated;
+  // Current frame # (walk)
+  long m_frame { 0 };
+  std::size_t m_budgetBytes;
+  bool m_budgetWarned { false };
+  ChildKernel m_kernel;
+};
+
+// Single element visited in ElemStore (valid during visit only)
+struct ElemRef {
+  ElemStore::Page & page;
+  long ind;    // within page
+  long slot;   // within order
+  long order;
+};
@@ -10,7 +10,9 @@
 #include "fluctuate.h"
 #include "animation.h"
 #include "fractal.h"
+#include "aux_func.h"
 #include <SFML/Window/Keyboard.hpp>
+#include <cmath>
 #include <cstdlib>
 #include <iostream>
 
@@ -22,7 +24,7 @@ bool MovFluctuate::key_decodation(sf::Keyboard::Key key) {
     if (!fluctuateState.windActive) {
       // copy Algo per level
       algo_data_fluctuate = conv_to_fluctuate(algo_data);
-      srand( time(NULL));
+      myAux::seed_random();
       // start wind (wobbling) modification
       fluctuateState.windActive = true;
     } else {
@@ -69,6 +71,21 @@ T_Fluctuate_Algo_Arr MovFluctuate::conv_to_fluctuate(T_Algo_Arr assym_algo){
   return temp_algo;
 }
 
+T_Child_Transform_Arr MovFluctuate::child_transforms() const {
+  T_Child_Transform_Arr transforms;
+  for (size_t level {0}; level <= cFrac::NrOfOrders; ++level) {
+    for (size_t ind {0}; ind < 2 * cFrac::NrOfElements; ++ind) {
+      const DRec & rule { algo_data_fluctuate[level][ind % cFrac::NrOfElements] };
+      // DOWN branch first
+      const float angle { (ind < cFrac::NrOfElements) ? rule.angle_down : rule.angle };
+      transforms[level].repos[ind] = rule.repos;
+      transforms[level].cos_scale[ind] = std::cos(angle) * rule.scale;
+      transforms[level].sin_scale[ind] = std::sin(angle) * rule.scale;
+    }
+  }
+  return transforms;
+}
+
 void MovFluctuate::stop_wind() {
   // stop wind (wobbling) modification if it was running
   fluctuateState.windActive = false;
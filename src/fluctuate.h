@@ -61,6 +61,9 @@ struct MovFluctuate : MovAnim {
 
   T_Fluctuate_Algo_Arr conv_to_fluctuate(T_Algo_Arr);
 
+  // Children transformations of current LIVE algo - once per frame
+  T_Child_Transform_Arr child_transforms() const;
+
   // Enable restart Growing effect
   void refreshWithRestartGrowing(void);
 
@@ -10,6 +10,7 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include "config.h"
 #include <SFML/Graphics.hpp>
 #include <optional>
@@ -41,13 +42,13 @@ namespace cFrac {
   
   // counter mark demo initialization
   inline constexpr int DemoInitCnt { 1 };
-
-  // Minimal time per frame drawing in ms
-  inline constexpr double MinTimePerFrame { 15.0 }; // 67Hz
 }
 
 enum BranchType { upBranch, downBranch, firstBranch };
-enum LightAngleCase {lAngleUnknown = 0, lAngleAbove90, lAngleBelow90};
+
+// Frame-level vertex batches for drawing stems - see stem_batch.h
+struct StemBatch;
+enum LightAngleCase : std::int8_t {lAngleUnknown = 0, lAngleAbove90, lAngleBelow90};
 
 // other Config Constants in tranform.h
 
@@ -81,11 +82,49 @@ private:
                        const T cos_val); // rotation matrix calculations
 };
 
+// Points at base of stem deciding about its drawn thickness
+struct ThickPoints {
+  float x1;
+  float y1;
+  float x2;
+  float y2;
+};
+
+// Frame-wide control of flash effect - snapshot of ColorPal/LightS state
+// (taken once per frame, so stems can be drawn by other thread)
+struct FlashCtrl {
+  bool globalFlash;       // flash with all stems
+  bool resetFlash;        // reset flash algo
+  bool lightActive;
+  sf::Vector2i lightVec;  // light rays vector
+  bool freezeTime;        // time freeze (stop) - flash effect kept
+  // current global state (see draw.cpp)
+  static FlashCtrl current(bool freezeTime);
+};
+
+// Flash Light state of single stem
+// values remain from previous frame unless explicitelly changed
+struct FlashState {
+  // active light flash of stem for # of frames
+  std::int8_t flash_cnt { 0 }; // no light flash
+  // light angle from previous frame / cycle
+  LightAngleCase prev_l_angle { lAngleUnknown };
+  // Single frame step of flash effect for stem vector dx,dy
+  // returns true if stem shall be drawn in Flash version
+  bool step(float dx, float dy, const FlashCtrl & ctrl);
+  // had angle between light rays and stem/vec changed (<90 vs >90 deg)
+  bool light_vec_angle_flip(float vx, float vy, sf::Vector2i lightVec);
+  static LightAngleCase light_vec_angle(float vx, float vy, sf::Vector2i lightVec);
+};
+
 // Additional points used for drawing stem with thickness
 // Warning: x#,y# values are recalculated each frame
 struct Stem{
   // thickness type
   enum ThickLevel {thickNone, thick1, thick2};
+  // thickness in fraction of parent stem
+  constexpr static float cThick1Fraction { 0.008f };
+  constexpr static float cThick2Fraction { 0.006f };
   Vec2D vec_xy; // bare line along centre of stem
   float x1 {};  // additional pofloats at base of stem
   float y1 {};  // deciding about their drawn thickness
@@ -102,7 +141,8 @@ struct Stem{
   // Calculate coordinates of stem with some possible adjustmement (due to autoscale)
   void recalculateStemWidthCoordinates(float cumulativeFactor);
 
-  virtual void draw_stem(sf::RenderWindow &win, long level, const bool freezeTime);
+  // append stem vertices to the frame batch (drawn at the end of frame)
+  virtual void draw_stem(StemBatch &batch, long level, const bool freezeTime);
   // // to be used by Flash Light version
   // virtual bool light_vec_angle_flip() = 0;
 };
@@ -110,15 +150,8 @@ struct Stem{
 // Stem with additional Flash Light handling
 // values remain from previous frame unless explicitelly changed
 struct StemFlash : Stem {
-  virtual void draw_stem(sf::RenderWindow & win, long level, const bool freezeTime);
-  // light angle from previous frame / cycle
-  LightAngleCase prev_l_angle;
-  // active light flash of stem for # of frames  
-  int flash_cnt { 0 }; // no light flash
-  // had angle between light rays and stem/vec changed (<90 vs >90 deg)
-  bool light_vec_angle_flip();
-private:
-  LightAngleCase light_vec_angle(float vx, float vy);
+  virtual void draw_stem(StemBatch & batch, long level, const bool freezeTime);
+  FlashState flash;
 };
 
 struct FluctuateState {
@@ -152,6 +185,21 @@ using T_Algo_Arr_Symm = std::array<DRecSymm, cFrac::NrOfElements>;
 // 0th order is primary element, then following orders 1..NrOfOrders - thus +1
 using T_Fluctuate_Algo_Arr = std::array<T_Algo_Arr, cFrac::NrOfOrders +1>;
 
+// Transformation of all children of element from their parent prepared
+// once per frame (see MovFluctuate::child_transforms): reposition and
+// rotation matrix already multiplied by scale - no sin/cos needed per element.
+// Columns of children: DOWN branch first then UP one (see child_kernel.h)
+struct ChildTransforms {
+  std::array<float, 2 * cFrac::NrOfElements> repos;
+  std::array<float, 2 * cFrac::NrOfElements> cos_scale;  // cos(angle) * scale
+  std::array<float, 2 * cFrac::NrOfElements> sin_scale;  // sin(angle) * scale
+};
+// Per order of children
+using T_Child_Transform_Arr = std::array<ChildTransforms, cFrac::NrOfOrders +1>;
+
+// # of elements (nodes) of every order
+using T_Order_Counts = std::array<long, cFrac::NrOfOrders +1>;
+
 /* Single Element of Fractal */
 struct Element {
   short order { 0 }; // nesting level
@@ -160,12 +208,7 @@ struct Element {
   BranchType b_type = firstBranch; // First branch valid only for first element
   // vetor / delta coordinates / stem thickness / Flash Light
   StemFlash stem_xy;   
-  // Attached up/downside child elements (of next order)
-  // in form of link list
-  std::array<Element, cFrac::NrOfElements> * children_down {};
-  std::array<Element, cFrac::NrOfElements> * children_up {};
-  // Link to parent (single one)
-  Element *parent_ptr {}; // pointer to previous already existing object
+  // Child/parent elements are not linked - see implicit indexing in elem_store.h
   // Tranform vec/stem from parent using special transformation array
   // - method for static (single frame) drawing
   void transform_vec_stem(const T_Fluctuate_Algo_Arr & algo_fluct_data);
@@ -0,0 +1,201 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "frame_output.h"
+#include "dbg_report.h"
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <system_error>
+
+WindowOutput::WindowOutput(const std::string & title, bool vsync)
+  : m_window { sf::VideoMode({cFrac::WindowXsize, cFrac::WindowYsize}), title }
+{
+  m_window.setVerticalSyncEnabled(vsync);
+  if (!m_stems.resize(m_window.getSize())) {
+    throw "Window stems texture can not be created";
+  }
+}
+
+void WindowOutput::draw(const FrameBatches & batches, bool unchanged) {
+  m_window.clear();
+  if (!unchanged) {
+    // Draw all collected stems at once
+    batches.flush(m_window);
+    m_stemsValid = false;
+    return;
+  }
+  // Unchanged frame - stems drawn (once) into texture, then texture only
+  if (!m_stemsValid) {
+    m_stems.clear();
+    batches.flush(m_stems);
+    m_stems.display();
+    m_stemsValid = true;
+  }
+  m_window.draw(sf::Sprite(m_stems.getTexture()));
+}
+
+
+OffscreenOutput::OffscreenOutput(long frames, RasterCfg raster)
+  : m_frames { frames }
+{
+  const sf::Vector2u size { cFrac::WindowXsize, cFrac::WindowYsize };
+  if (raster.cpu) {
+    m_raster = std::make_unique<CpuRaster>(size, raster.threads);
+  } else {
+    m_texture = std::make_unique<sf::RenderTexture>();
+    if (!m_texture->resize(size)) {
+      throw "Offscreen render texture can not be created (no OpenGL context?) - try --raster cpu";
+    }
+  }
+  Dbg::report_info("Offscreen CPU raster: ", raster.cpu);
+  Dbg::report_info("Offscreen # of frames: ", m_frames);
+}
+
+void OffscreenOutput::draw(const FrameBatches & batches, bool unchanged) {
+  if (m_raster) {
+    // framebuffer of unchanged frame kept (no overlay)
+    if (!unchanged) {
+      m_raster->clear();
+      m_raster->draw(batches);
+    }
+  } else {
+    m_texture->clear();
+    batches.flush(*m_texture);
+  }
+}
+
+sf::Vector2u OffscreenOutput::size() const {
+  return m_raster ? m_raster->size() : m_texture->getSize();
+}
+
+const sf::Image & OffscreenOutput::image() {
+  if (m_raster) {
+    m_image = sf::Image(m_raster->size(), m_raster->pixels());
+  } else {
+    m_texture->display();
+    m_image = m_texture->getTexture().copyToImage();
+  }
+  return m_image;
+}
+
+const std::uint8_t * OffscreenOutput::pixels() {
+  // CPU framebuffer used directly (no copy)
+  return m_raster ? m_raster->pixels() : image().getPixelsPtr();
+}
+
+
+ImageOutput::ImageOutput(const std::filesystem::path & dir, long frames, RasterCfg raster)
+  : OffscreenOutput { frames, raster }
+  , m_dir { dir }
+{
+  std::error_code ec;
+  std::filesystem::create_directories(m_dir, ec);
+  if (ec) {
+    Dbg::report_error("Frames directory can not be created: " + m_dir.string() + " ", 0);
+    close();
+    return;
+  }
+  Dbg::report_info("Headless frames written to: " + m_dir.string());
+}
+
+
+void ImageOutput::display() {
+  std::ostringstream name;
+  name << "frame_" << std::setw(5) << std::setfill('0') << m_frame << ".png";
+  const std::filesystem::path file { m_dir / name.str() };
+  if (!image().saveToFile(file)) {
+    Dbg::report_error("Frame image can not be written: " + file.string() + " ", m_frame);
+    close();
+    return;
+  }
+  ++m_frame;
+}
+
+
+StreamOutput::StreamOutput(const std::string & file, Format format, int fps, long frames,
+                           RasterCfg raster)
+  : OffscreenOutput { frames, raster }
+  , m_format { format }
+{
+  if (file == "-") {
+    // Stdout is the video stream now - other outputs go to stderr
+    // (till the end of program, also final summary)
+    std::cout.rdbuf(std::cerr.rdbuf());
+    m_stream = stdout;
+  } else {
+    m_stream = std::fopen(file.c_str(), "wb");
+  }
+  if (m_stream == nullptr) {
+    Dbg::report_error("Video stream can not be opened: " + file + " ", 0);
+    close();
+    return;
+  }
+  Dbg::report_info("Video stream written to: " + file);
+
+  if (m_format == y4m) {
+    m_planes.resize(std::size_t { 3 } * cFrac::WindowXsize * cFrac::WindowYsize);
+    std::ostringstream header;
+    header << "YUV4MPEG2 W" << cFrac::WindowXsize << " H" << cFrac::WindowYsize
+           << " F" << fps << ":1 Ip A1:1 C444\n";
+    const std::string str { header.str() };
+    if (!write(str.data(), str.size())) { close(); }
+  }
+}
+
+StreamOutput::~StreamOutput() {
+  if (m_stream == nullptr) { return; }
+  if (m_stream == stdout) {
+    std::fflush(m_stream);
+  } else {
+    std::fclose(m_stream);
+  }
+}
+
+
+bool StreamOutput::write(const void * data, std::size_t size) {
+  if (std::fwrite(data, 1, size, m_stream) != size) {
+    Dbg::report_error("Video stream write failed, frame: ", m_frame);
+    return false;
+  }
+  return true;
+}
+
+
+void StreamOutput::display() {
+  const std::uint8_t * pixel { pixels() };
+  const std::size_t count { std::size_t { size().x } * size().y };
+
+  bool written { false };
+  if (m_format == rgba) {
+    written = write(pixel, count * 4);
+  } else {
+    // RGB to YCbCr (BT.601, limited range) - Y, U, V planes
+    std::uint8_t * y { m_planes.data() };
+    std::uint8_t * u { y + count };
+    std::uint8_t * v { u + count };
+    for (std::size_t i { 0 }; i < count; ++i, pixel += 4) {
+      const int r { pixel[0] };
+      const int g { pixel[1] };
+      const int b { pixel[2] };
+      y[i] = static_cast<std::uint8_t>((( 66 * r + 129 * g +  25 * b + 128) >> 8) +  16);
+      u[i] = static_cast<std::uint8_t>(((-38 * r -  74 * g + 112 * b + 128) >> 8) + 128);
+      v[i] = static_cast<std::uint8_t>(((112 * r -  94 * g -  18 * b + 128) >> 8) + 128);
+    }
+    static const char frameHeader[] { "FRAME\n" };
+    written = write(frameHeader, sizeof(frameHeader) -1)
+              and write(m_planes.data(), m_planes.size());
+  }
+  if (!written) {
+    close();
+    return;
+  }
+  ++m_frame;
+}
@@ -0,0 +1,124 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "cpu_raster.h"
+#include "fractal.h"
+#include "stem_batch.h"
+#include <SFML/Graphics.hpp>
+#include <SFML/Window/Event.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Destinations of drawn frames - frame loop (main.cpp) works with any of them:
+//   open()      - more frames wanted
+//   close()     - no more frames
+//   pollEvent() - user events (if any)
+//   draw()      - new frame with stems of batches (unchanged - the same
+//                 stems as previous frame, drawing may be reused)
+//   overlay()   - target for other drawings on top of stems (if any)
+//   display()   - frame drawing finished (shown or written)
+//   cKeepRate   - frames paced by FrameScheduler (see scheduler.h)
+
+// On-screen window - frames until it is closed.
+// Stems of unchanged frames are drawn once into texture which is then
+// reused - idle window costs no vertex upload.
+struct WindowOutput {
+  // vsync - frames synchronized with display refresh
+  WindowOutput(const std::string & title, bool vsync);
+
+  bool open() const { return m_window.isOpen(); }
+  void close() { m_window.close(); }
+  std::optional<sf::Event> pollEvent() { return m_window.pollEvent(); }
+  void draw(const FrameBatches & batches, bool unchanged);
+  sf::RenderTarget * overlay() { return &m_window; }
+  void display() { m_window.display(); }
+  constexpr static bool cKeepRate { true };
+
+private:
+  sf::RenderWindow m_window;
+  sf::RenderTexture m_stems;
+  bool m_stemsValid { false }; // texture holds stems of current frame
+};
+
+// Drawing of offscreen frames
+struct RasterCfg {
+  bool cpu { false }; // CPU rasterizer (stems only) instead of SFML texture
+  int threads { 1 };  // # of CPU rasterizer threads (0 - all hardware threads)
+};
+
+// Offscreen (headless) - given # of frames is drawn, as fast as possible,
+// either by CPU rasterizer - no OpenGL context thus no display server
+// needed, but without light and text artefacts (no overlay) - or to SFML
+// render texture, which needs OpenGL context (on Linux display server)
+struct OffscreenOutput {
+  OffscreenOutput(long frames, RasterCfg raster);
+
+  bool open() const { return m_frame < m_frames; }
+  void close() { m_frames = m_frame; }
+  std::optional<sf::Event> pollEvent() { return std::nullopt; }
+  void draw(const FrameBatches & batches, bool unchanged);
+  sf::RenderTarget * overlay() { return m_texture.get(); }
+  constexpr static bool cKeepRate { false };
+
+protected:
+  // Drawn frame (valid till next draw)
+  const sf::Image & image();
+  const std::uint8_t * pixels();
+  sf::Vector2u size() const;
+
+  std::unique_ptr<sf::RenderTexture> m_texture;
+  std::unique_ptr<CpuRaster> m_raster;
+  sf::Image m_image;
+  long m_frames;
+  long m_frame { 0 };
+};
+
+// Frames written to image files frame_00000.png, frame_00001.png ...
+// in given directory
+struct ImageOutput : OffscreenOutput {
+  ImageOutput(const std::filesystem::path & dir, long frames, RasterCfg raster);
+  void display();
+
+private:
+  std::filesystem::path m_dir;
+};
+
+// Frames streamed as raw video to file, named pipe or stdout ("-"),
+// e.g. to be piped into encoder: frexe --stream - | ffmpeg -i - out.mp4
+// Frames are never dropped - stream is written at its reader speed.
+//   y4m  - YUV4MPEG2 (4:4:4, BT.601) with given frame rate in header
+//   rgba - bare RGBA pixels (frame rate and size to be given to reader)
+struct StreamOutput : OffscreenOutput {
+  enum Format { y4m, rgba };
+  StreamOutput(const std::string & file, Format format, int fps, long frames,
+               RasterCfg raster);
+  ~StreamOutput();
+
+  // Disable copy/move - owns the stream
+  StreamOutput(const StreamOutput &) = delete;
+  StreamOutput & operator=(const StreamOutput &) = delete;
+
+  void display();
+
+private:
+  bool write(const void * data, std::size_t size);
+
+  std::FILE * m_stream { nullptr };
+  Format m_format;
+  // Y, U, V planes of single frame - kept between frames
+  std::vector<std::uint8_t> m_planes;
+};
@@ -0,0 +1,63 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "garbage_coll.h"
+#include "dbg_report.h"
+#include <cassert>
+#include <new>
+
+SlabArena::SlabArena(std::size_t slotSize, std::size_t blockSize)
+  : m_slotSize { (slotSize + cAlign -1) / cAlign * cAlign }
+  , m_slotsPerBlock { blockSize / m_slotSize }
+{
+  assert(m_slotsPerBlock > 0 and "block shall keep at least one slot");
+}
+
+void * SlabArena::allocate() {
+  ++m_used;
+  if (m_used > m_peak) { m_peak = m_used; }
+
+  if (m_free != nullptr) {
+    // reuse released slot
+    FreeSlot * const slot { m_free };
+    m_free = slot->next;
+    return slot;
+  }
+
+  const std::size_t block { m_carved / m_slotsPerBlock };
+  if (block >= m_blocks.size()) {
+    // one more block (extra room for alignment)
+    m_blocks.push_back(std::make_unique<std::byte[]>(m_slotsPerBlock * m_slotSize + cAlign));
+    Dbg::report_info("Element arena grown to (bytes reserved): ",
+                     static_cast<long>(bytes_reserved()));
+  }
+
+  void * base { m_blocks[block].get() };
+  std::size_t space { m_slotsPerBlock * m_slotSize + cAlign };
+  base = std::align(cAlign, m_slotsPerBlock * m_slotSize, base, space);
+  assert(base != nullptr);
+
+  void * slot { static_cast<std::byte *>(base) + (m_carved % m_slotsPerBlock) * m_slotSize };
+  ++m_carved;
+  return slot;
+}
+
+void SlabArena::release(void * slot) {
+  assert(m_used > 0);
+  --m_used;
+  m_free = new (slot) FreeSlot { m_free };
+}
+
+void SlabArena::reset() {
+  Dbg::report_info("Element arena reset, used (bytes): ", static_cast<long>(bytes_used()));
+  m_used = 0;
+  m_carved = 0;
+  m_free = nullptr;
+}
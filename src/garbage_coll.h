@@ -9,60 +9,70 @@
 
 #include "fractal.h"
 #include "dbg_report.h"
+#include "elem_store.h"
+#include <cstddef>
 #include <iostream>
 #include <memory>
 #include <vector>
 
-// Collects link pointers ownership - Garbage Collector
+// Slab arena - hands out equal size slots (store pages) from big contiguous
+// blocks. Single slots can be released (kept on free list for reuse)
+// or everything is freed at once by reset. Blocks are kept and reused,
+// so regrowing causes no heap allocation.
+struct SlabArena {
+  SlabArena(std::size_t slotSize, std::size_t blockSize);
+  // Disable copy/move - slots are referenced by raw pointers
+  SlabArena(const SlabArena &) = delete;
+  SlabArena & operator=(const SlabArena &) = delete;
+
+  // Uninitialized memory of slotSize bytes
+  void * allocate();
+  // Slot free again (for next allocate)
+  void release(void * slot);
+  // All slots free again
+  void reset();
+
+  std::size_t bytes_reserved() const { return m_blocks.size() * m_slotsPerBlock * m_slotSize; }
+  std::size_t bytes_used() const { return m_used * m_slotSize; }
+  std::size_t bytes_peak() const { return m_peak * m_slotSize; }
+
+private:
+  // Slots are cache line aligned
+  constexpr static std::size_t cAlign { 64 };
+
+  std::size_t m_slotSize;
+  std::size_t m_slotsPerBlock;
+  std::vector<std::unique_ptr<std::byte[]>> m_blocks;
+  // Released slot - link to next one kept in slot memory itself
+  struct FreeSlot {
+    FreeSlot * next;
+  };
+
+  std::size_t m_carved { 0 }; // # of slots taken from blocks (block by block)
+  FreeSlot * m_free { nullptr };
+  std::size_t m_used { 0 };   // # of slots in use
+  std::size_t m_peak { 0 };
+};
+
+// Memory management of fractal elements - Garbage Collector
+// (elements are not linked by pointers - see elem_store.h)
 // Dbg: Collects and reports debug info from every other class
 struct MemAndDebug : Dbg
 {
-  MemAndDebug(){
-    elementPtrsCnt = 0;
-  }
   // explicit destructor always virtual: learncpp 25.4
+  // (arena usage reported by Dbg::report_summary)
   virtual ~MemAndDebug(){
 #ifndef NDEBUG
     std::cerr << "Garbage Collector (Memory management) auto clean-up Done." << std::endl;
 #endif
   }
 
-  
-  // Add ownership pointer to the collection
-  static void collectElementPtr(std::unique_ptr<std::array<Element, cFrac::NrOfElements>> ptr) {
-    allElementPtrs.push_back(std::move(ptr));
-    ++elementPtrsCnt;
-
-    if (Dbg::cReportWarning) {
-      if (elementPtrsCnt >= Dbg::cCreatePointersThreshold) {
-        Dbg::report_mltpl_warning( Dbg::mltplPointers, elementPtrsCnt);
-      }
-    }
-
-    // Check some very Big Number
-    if (Dbg::cReportError and elementPtrsCnt > 50'000'000) {
-      Dbg::report_error("Too large # of u ptrs collected: ", elementPtrsCnt);
-      // Fatal Error
-      release_all();
-      throw "Too large number of elements created.";
-    }
+  // Arena of ElemStore pages
+  static SlabArena & elem_arena() {
+    // 2MB blocks
+    static SlabArena arena { sizeof(ElemStore::Page), 2 * 1024 * 1024 };
+    return arena;
   }
-
-    // Explicit release all allocated data from the collection
-  static void release_all(){
-    // Release all (manually) in reverse order
-    for (auto rit { MemAndDebug::allElementPtrs.rbegin() }; rit != MemAndDebug::allElementPtrs.rend(); ++rit)  {
-      rit->reset();  // release allocated data
-    }
-    allElementPtrs.clear();  // clear vector itself
-    std::cerr << "Garbage collector manually clean-up\n";
-  }
-
-  private:
-  static unsigned long elementPtrsCnt; 
-  // Collection of Element pointers ownership
-  static std::vector<std::unique_ptr<std::array<Element, cFrac::NrOfElements>>> allElementPtrs;
 };
 
 // extern GarbColl gc;
-
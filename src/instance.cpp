@@ -0,0 +1,81 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "instance.h"
+#include <cmath>
+
+static bool same_transforms(const ChildTransforms & t1, const ChildTransforms & t2) {
+  return t1.repos == t2.repos and t1.cos_scale == t2.cos_scale and
+         t1.sin_scale == t2.sin_scale;
+}
+
+
+void SubtreeInstance::update(const T_Child_Transform_Arr & child_transforms, long order,
+                             long maxOrder, float rootLength, float smallVec) {
+  // Children of stem are walked if |dx| + |dy| >= smallVec - never
+  // if sqrt(2) * length < smallVec, relative length is enough then
+  const float minLength { smallVec / (std::sqrt(2.0f) * rootLength) };
+
+  bool rebuild { order != m_order or maxOrder != m_maxOrder or minLength < m_minLength };
+  for (long child_order { order +1 }; !rebuild and child_order <= maxOrder; ++child_order) {
+    rebuild = !same_transforms(child_transforms[child_order], m_transforms[child_order]);
+  }
+  if (rebuild) {
+    m_transforms = child_transforms;
+    m_order = order;
+    m_maxOrder = maxOrder;
+    m_minLength = minLength;
+    build(child_transforms, minLength);
+  }
+}
+
+
+// Same transformation of children as ElemStore::transform_children;
+// pushed in reverse - to be listed DOWN branch first, from first element
+void SubtreeInstance::push_children(const Stem & parent, long parentInd,
+                                    const T_Child_Transform_Arr & child_transforms) {
+  const ChildTransforms & rules { child_transforms[parent.order +1] };
+  for (long child { static_cast<long>(rules.repos.size()) -1 }; child >= 0; --child) {
+    m_pending.push_back({ { parent.x + parent.dx * rules.repos[child],
+                            parent.y + parent.dy * rules.repos[child],
+                            parent.dx * rules.cos_scale[child] - parent.dy * rules.sin_scale[child],
+                            parent.dx * rules.sin_scale[child] + parent.dy * rules.cos_scale[child],
+                            parent.order +1, 1 },
+                          parentInd });
+  }
+}
+
+
+void SubtreeInstance::build(const T_Child_Transform_Arr & child_transforms, float minLength) {
+  m_stems.clear();
+  m_parents.clear();
+  m_pending.clear();
+
+  // Root vector itself is drawn as element of store
+  push_children({ 0.0f, 0.0f, 1.0f, 0.0f, m_order, 1 }, -1, child_transforms);
+  while (!m_pending.empty()) {
+    const Pending pending { m_pending.back() };
+    m_pending.pop_back();
+    const long ind { static_cast<long>(m_stems.size()) };
+    m_stems.push_back(pending.stem);
+    m_parents.push_back(pending.parent);
+    if (pending.stem.order < m_maxOrder and
+        std::hypot(pending.stem.dx, pending.stem.dy) >= minLength) {
+      push_children(pending.stem, ind, child_transforms);
+    }
+  }
+
+  // Subtree sizes - every stem is listed after its parent
+  for (long ind { static_cast<long>(m_stems.size()) -1 }; ind >= 0; --ind) {
+    if (m_parents[ind] >= 0) {
+      m_stems[m_parents[ind]].skip += m_stems[ind].skip;
+    }
+  }
+}
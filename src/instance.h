@@ -0,0 +1,62 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "fractal.h"
+#include <vector>
+
+// Self-similarity instancing: all subtrees of the same order are affine
+// copies of each other (children transformations are the same per order,
+// wind and growing included), so children subtree of order is computed
+// once per frame in coordinates of its root vector (root base at 0,0,
+// vector 1,0) as flat list of stems. Subtree of every element of that
+// order is then drawn by moving the list by element vector
+// (x + x' * v + y' * v_perp) - no store, no traversal.
+// List is in depth-first order of ElementsWalk, every stem knows size
+// of its subtree - subtrees pruned by walk limits are jumped over.
+struct SubtreeInstance {
+  // Stem of instance in root vector coordinates
+  struct Stem {
+    float x, y, dx, dy;
+    long order;
+    long skip;  // # of stems of its subtree (itself included)
+  };
+
+  // Rebuild instance of children subtree of order (once per frame) if
+  // transformations changed or roots up to rootLength need more detail
+  // than built; children of stems shorter than smallVec are not walked
+  void update(const T_Child_Transform_Arr & child_transforms, long order, long maxOrder,
+              float rootLength, float smallVec);
+
+  // Stems of instance - empty before first update
+  const std::vector<Stem> & stems() const { return m_stems; }
+
+private:
+  void build(const T_Child_Transform_Arr & child_transforms, float minLength);
+  void push_children(const Stem & parent, long parentInd,
+                     const T_Child_Transform_Arr & child_transforms);
+
+  // Stem waiting for being listed (single build)
+  struct Pending {
+    Stem stem;
+    long parent;  // index in m_stems, -1 - root
+  };
+
+  // Transformations, orders and detail instance was built for
+  T_Child_Transform_Arr m_transforms {};
+  long m_order { -1 };
+  long m_maxOrder { -1 };
+  float m_minLength { 0.0f };  // relative to root vector
+  std::vector<Stem> m_stems;
+  // Single build: parent of every stem in m_stems and stems to be listed
+  std::vector<long> m_parents;
+  std::vector<Pending> m_pending;
+};
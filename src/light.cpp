@@ -84,19 +84,28 @@ LightS::RetResult LightS::key_decodation(sf::Keyboard::Key key){
 }
 
 
-// Light redraw per cycle
-void LightS::light_draw(sf::RenderWindow &win){
+// Light move per cycle - by held keys (if keyboard), demo or sweep
+void LightS::light_move(bool keyboard){
   
   // Move realization
   // Reposition smoothly light while key is being pressed or if demo
-  if ((sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D)) or 
-      (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Right))) {
+  if (keyboard and
+      ((sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D)) or 
+       (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Right)))) {
     move_light_position_by(cMoveSmooth);   // to right
     m_lightMoving = rightMove;
-  } else if ((sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A)) or
-            (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Left))) {
+  } else if (keyboard and
+             ((sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A)) or
+              (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Left)))) {
     move_light_position_by(-cMoveSmooth);  // to left
     m_lightMoving = leftMove;
+  } else if (m_sweep) {
+    // Edge to edge - direction reversed when light can not move further
+    const int lightX { s_lightVec.x };
+    move_light_position_by(leftMove == m_lightMoving ? -cMoveSmooth : cMoveSmooth);
+    if (lightX == s_lightVec.x) {
+      m_lightMoving = (leftMove == m_lightMoving) ? rightMove : leftMove;
+    }
   } else {
     if (m_demoMode) {
       // In demo mode light modes are changed auto by demoGenerator
@@ -107,6 +116,13 @@ void LightS::light_draw(sf::RenderWindow &win){
       }
     }
   }
+}
+
+
+// Light redraw per cycle
+void LightS::light_draw(sf::RenderTarget &win){
+  
+  light_move(true);
   
   // Draw rainbow of all possible colors
   win.draw(lrainbow);
@@ -118,10 +134,9 @@ void LightS::light_draw(sf::RenderWindow &win){
 
   // Draw Main Light if active
   if (s_lightActive) {
-    sf::CircleShape shape(MAIN_SPOT_R);
-    shape.setFillColor(s_lightColor);
-    shape.setPosition(position);
-    win.draw(shape);
+    m_lightSpot.setFillColor(s_lightColor);
+    m_lightSpot.setPosition(position);
+    win.draw(m_lightSpot);
   }
 
   // Draw optionally light rays grid
@@ -132,7 +147,7 @@ void LightS::light_draw(sf::RenderWindow &win){
     // Put postion at centre of light
     position.x += MAIN_SPOT_R; 
     position.y += MAIN_SPOT_R; 
-    lrays_grid = create_rays_grid(position);
+    create_rays_grid(position);
     win.draw(lrays_grid);
   }
 }
@@ -187,12 +202,19 @@ void LightS::rotate_rgb_color_updown(MoveColor updn){
 void LightS::one_step_light_resume(void) {
   // without keeping keypress next cycle will be without light move
   // This is to set noMove mode alfter releasing the key
-  if (!m_demoMode) {
+  if (!m_demoMode and !m_sweep) {
     m_lightMoving = noMove;
   }
 }
 
 
+// Light moved continuously from edge to edge (e.g. benchmark)
+void LightS::sweep_light() {
+  m_sweep = true;
+  m_lightMoving = rightMove;
+}
+
+
 // Create signle ray line consisting of sections
 void LightS::create_ray_line(sf::Vector2f current_line_pos, bool s_fill, 
                              sf::VertexArray &auxg) {
@@ -242,10 +264,12 @@ void LightS::create_ray_line(sf::Vector2f current_line_pos, bool s_fill,
 }
 
 
-// Based on Light position draw rays
-sf::VertexArray LightS::create_rays_grid(sf::Vector2f lpos) {
+// Based on Light position (re)build rays grid
+// reusing vertex storage from previous frame
+void LightS::create_rays_grid(sf::Vector2f lpos) {
   
-  sf::VertexArray auxg(sf::PrimitiveType::Lines);
+  sf::VertexArray & auxg { lrays_grid };
+  auxg.clear(); // keeps already allocated storage
 
   sf::Vector2f line_pos = lpos;
   bool start_fill = true;
@@ -295,8 +319,6 @@ sf::VertexArray LightS::create_rays_grid(sf::Vector2f lpos) {
            "Too much grid lines. Possible Infinite loop.");
     // till right side of window with margin
   } while (line_pos.x < X_MID *3);
-
-  return auxg;
 }
 
 
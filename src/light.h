@@ -11,8 +11,10 @@
 
 #include "dbg_report.h"
 #include "fractal.h"
+#include <SFML/Graphics/CircleShape.hpp>
 #include <SFML/Graphics/Color.hpp>
 #include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/System/Vector2.hpp>
 
@@ -44,8 +46,14 @@ struct LightS {
   // command light color and position
   RetResult key_decodation(sf::Keyboard::Key key);
 
-  // Light redraw per cycle
-  void light_draw(sf::RenderWindow &win);
+  // Light move per cycle - held keys checked only if keyboard is available
+  void light_move(bool keyboard);
+
+  // Light redraw per cycle (including move)
+  void light_draw(sf::RenderTarget &win);
+
+  // Light moved continuously from edge to edge (e.g. benchmark)
+  void sweep_light();
 
   void reset_light();
 
@@ -93,14 +101,20 @@ private:
   // Backup colors circle
   sf::VertexArray lrainbow;
 
-  // Light rays (visualisation) grid
-  sf::VertexArray lrays_grid {};
+  // Light rays (visualisation) grid - storage reused every frame
+  sf::VertexArray lrays_grid { sf::PrimitiveType::Lines };
+
+  // Main light spot - created once, only color/position changed per frame
+  sf::CircleShape m_lightSpot { MAIN_SPOT_R };
   
   // (Mode of) Presence of rays grid visualization
   RaysMode rays_mode;
 
   bool m_demoMode;
 
+  // Light swept from edge to edge
+  bool m_sweep { false };
+
   // Attenuate color
   sf::Color dim_color(sf::Color color, unsigned int percent); 
   
@@ -110,8 +124,8 @@ private:
   // Move position of light
   void move_light_position_by(int move);
   
-  // Based on Light position draw rays (multi-line)
-  sf::VertexArray create_rays_grid(sf::Vector2f l_pos);
+  // Based on Light position (re)build rays (multi-line) in lrays_grid
+  void create_rays_grid(sf::Vector2f l_pos);
 
   // Create signle ray line consisting of sections
   void create_ray_line(sf::Vector2f init_pos, bool start_fill, 
@@ -0,0 +1,128 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "lod.h"
+#include "dbg_report.h"
+#include "traverse.h"
+#include <algorithm>
+#include <cmath>
+
+LodImpostors::LodImpostors(float size)
+  : m_size { std::max(size, 0.0f) }
+  , m_grid { std::clamp(static_cast<int>(std::ceil(2.0f * m_size)), 2, cMaxGrid) }
+{
+  if (active()) {
+    m_cells.resize(static_cast<std::size_t>(m_grid) * m_grid);
+    Dbg::report_info("LOD impostors grid (cells per side): ", m_grid);
+  }
+}
+
+
+// FNV-1a over raw bytes
+std::uint64_t LodImpostors::hash(std::uint64_t key, const void * data, std::size_t size) {
+  constexpr static std::uint64_t cPrime { 1099511628211ULL };
+  const auto * bytes { static_cast<const unsigned char *>(data) };
+  for (std::size_t ind { 0 }; ind < size; ++ind) {
+    key = (key ^ bytes[ind]) * cPrime;
+  }
+  return key;
+}
+
+
+// Subtree of order depends on transformations and colors of all higher orders -
+// keys are chained from the highest order down
+void LodImpostors::update(const T_Child_Transform_Arr & child_transforms,
+                          const SubtreeReach & reach, const StemPalettes & palettes,
+                          long maxOrder, float smallVec) {
+  constexpr static std::uint64_t cOffsetBasis { 14695981039346656037ULL };
+  std::uint64_t key { hash(cOffsetBasis, &maxOrder, sizeof(maxOrder)) };
+  key = hash(key, &smallVec, sizeof(smallVec));
+  for (long order { maxOrder -1 }; order >= 0; --order) {
+    key = hash(key, &child_transforms[order +1], sizeof(ChildTransforms));
+    key = hash(key, &palettes.colors(false, order +1), sizeof(StemColor));
+    if (m_orders[order].key != key) {
+      m_orders[order].key = key;
+      build(order, child_transforms, reach, palettes, maxOrder, smallVec);
+    }
+  }
+}
+
+
+// Coverage of children subtree of root vector (0,0 -> 1,0) on grid spanning
+// subtree circle - stems are sampled twice per cell and color of cell is
+// average of its samples; subtree is descended while stems are at least
+// a cell long and not smaller than small vector of the largest root drawn
+// by impostor (subtree radius m_size). Root stem itself is drawn as usual.
+void LodImpostors::build(long order, const T_Child_Transform_Arr & child_transforms,
+                         const SubtreeReach & reach, const StemPalettes & palettes,
+                         long maxOrder, float smallVec) {
+  const float radius { reach.factor[order] };
+  const float cell { 2.0f * radius / m_grid };
+  // small vector relative to root vector (of length m_size / radius)
+  const float relSmallVec { smallVec * radius / m_size };
+  std::fill(m_cells.begin(), m_cells.end(), Coverage {});
+
+  auto push_children = [&](const Stem & parent) {
+    const ChildTransforms & rules { child_transforms[parent.order +1] };
+    for (std::size_t child { 0 }; child < rules.repos.size(); ++child) {
+      m_next.push_back({ parent.x + parent.dx * rules.repos[child],
+                         parent.y + parent.dy * rules.repos[child],
+                         parent.dx * rules.cos_scale[child] - parent.dy * rules.sin_scale[child],
+                         parent.dx * rules.sin_scale[child] + parent.dy * rules.cos_scale[child],
+                         parent.order +1 });
+    }
+  };
+
+  m_next.clear();
+  push_children({ 0.0f, 0.0f, 1.0f, 0.0f, order });
+  while (!m_next.empty()) {
+    std::swap(m_level, m_next);
+    m_next.clear();
+    for (const Stem & stem : m_level) {
+      const float length { std::hypot(stem.dx, stem.dy) };
+      const StemColor & colors { palettes.colors(false, stem.order) };
+      const int samples { std::max(1, static_cast<int>(std::ceil(2.0f * length / cell))) };
+      for (int sample { 0 }; sample <= samples; ++sample) {
+        const float t { static_cast<float>(sample) / samples };
+        const int cx { static_cast<int>(std::floor((stem.x + stem.dx * t + radius) / cell)) };
+        const int cy { static_cast<int>(std::floor((stem.y + stem.dy * t + radius) / cell)) };
+        if (cx < 0 or cy < 0 or cx >= m_grid or cy >= m_grid) {
+          continue;
+        }
+        const sf::Color color { lerp_color(colors.begin_c, colors.end_c, t) };
+        Coverage & covered { m_cells[static_cast<std::size_t>(cy) * m_grid + cx] };
+        covered.r += color.r;
+        covered.g += color.g;
+        covered.b += color.b;
+        ++covered.samples;
+      }
+
+      if (stem.order < maxOrder and length >= cell and
+          std::abs(stem.dx) + std::abs(stem.dy) >= relSmallVec) {
+        push_children(stem);
+      }
+    }
+  }
+
+  std::vector<Point> & points { m_orders[order].points };
+  points.clear();
+  for (int cy { 0 }; cy < m_grid; ++cy) {
+    for (int cx { 0 }; cx < m_grid; ++cx) {
+      const Coverage & covered { m_cells[static_cast<std::size_t>(cy) * m_grid + cx] };
+      if (covered.samples != 0) {
+        const float weight { 1.0f / covered.samples };
+        const sf::Color color { static_cast<std::uint8_t>(covered.r * weight + 0.5f),
+                                static_cast<std::uint8_t>(covered.g * weight + 0.5f),
+                                static_cast<std::uint8_t>(covered.b * weight + 0.5f) };
+        points.push_back({ (cx + 0.5f) * cell - radius, (cy + 0.5f) * cell - radius, color });
+      }
+    }
+  }
+}
@@ -0,0 +1,93 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "colors.h"
+#include "fractal.h"
+#include <SFML/Graphics/Color.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Subtrees bound - see traverse.h
+struct SubtreeReach;
+
+// Level of detail (LOD): subtrees smaller than given size (radius in pixels,
+// see SubtreeReach) are not walked - they are drawn by impostor: point cloud
+// of their coverage, precomputed per order.
+// All subtrees of the same order are affine copies of each other (children
+// transformations are the same per order), so impostor computed in
+// coordinates of its root vector (root base at 0,0, vector 1,0) is valid
+// for any root element: point along/across is moved to x + along * v + across * v_perp.
+// Impostor of order is rebuilt only when its transformations, colors or
+// small vector change. Subtree is descended like by walk (small vector) of
+// the largest root drawn by impostor - smaller roots are pruned even more.
+// Stems of impostors have no flash effect - impostors are not drawn while
+// light is active (see ParallelWalk::walk).
+struct LodImpostors {
+  // Point of impostor in root vector coordinates
+  struct Point {
+    float along;
+    float across;
+    sf::Color color;
+  };
+
+  // Largest impostor grid (cells per side)
+  constexpr static int cMaxGrid { 32 };
+  // Largest subtree radius - grid of 2 cells per pixel (no sparse dots)
+  constexpr static float cMaxSize { cMaxGrid / 2 };
+
+  // size - subtree radius (in pixels) below which impostors are drawn (0 - off)
+  explicit LodImpostors(float size);
+
+  bool active() const { return m_size > 0.0f; }
+  float size() const { return m_size; }
+
+  // Rebuild impostors of orders whose subtree changed (once per frame);
+  // smallVec - children of smaller stems are not walked (see WalkLimits)
+  void update(const T_Child_Transform_Arr & child_transforms, const SubtreeReach & reach,
+              const StemPalettes & palettes, long maxOrder, float smallVec);
+
+  // Impostor of (children subtree of) element of given order
+  const std::vector<Point> & impostor(long order) const { return m_orders[order].points; }
+
+private:
+  // Stem of impostor subtree being rasterized into grid
+  struct Stem {
+    float x, y, dx, dy;
+    long order;
+  };
+  // Sum of colors of stem samples within single cell
+  struct Coverage {
+    float r, g, b;
+    int samples;
+  };
+  struct Order {
+    std::uint64_t key { 0 }; // hash of transformations and colors of subtree
+    std::vector<Point> points;
+  };
+
+  void build(long order, const T_Child_Transform_Arr & child_transforms,
+             const SubtreeReach & reach, const StemPalettes & palettes, long maxOrder,
+             float smallVec);
+  static std::uint64_t hash(std::uint64_t key, const void * data, std::size_t size);
+
+  float m_size;
+  // # of cells per side of grid (about 1 pixel per cell at size)
+  int m_grid;
+  std::array<Order, cFrac::NrOfOrders +1> m_orders;
+  // Grid of single build (samples 0 - not covered)
+  std::vector<Coverage> m_cells;
+  // Stems of current and next order of single build
+  std::vector<Stem> m_level;
+  std::vector<Stem> m_next;
+};
@@ -14,7 +14,7 @@
 #include "fractal.h"
 #include "text_draw.h"
 #include "transform.h"
-#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Window/Keyboard.hpp>
 #include <filesystem>
 #include <fstream>
@@ -48,7 +48,7 @@ void LogText::startSavedDraw(void) {
 }
 
 // Draw Help if requested (counter per frame)
-void LogText::help_draw(sf::RenderWindow & win) {
+void LogText::help_draw(sf::RenderTarget & win) {
   if (help_draw_cnt > 0) {
     textDraw.help_draw(win);
     --help_draw_cnt;
@@ -56,7 +56,7 @@ void LogText::help_draw(sf::RenderWindow & win) {
 }
 
 // Draw Speed if requested (counter per frame)
-void LogText::speed_draw(sf::RenderWindow & win, int speed) {
+void LogText::speed_draw(sf::RenderTarget & win, int speed) {
   if (speed_scale_draw_cnt > 0) {
     --speed_scale_draw_cnt;
     textDraw.speed_draw(win, speed);
@@ -64,7 +64,7 @@ void LogText::speed_draw(sf::RenderWindow & win, int speed) {
 }
 
 // 'Saved' confirmation after F2
-void LogText::saved_draw(sf::RenderWindow & win) {
+void LogText::saved_draw(sf::RenderTarget & win) {
   if (m_saved_draw_cnt > 0) {
     textDraw.saved_draw(win);
     --m_saved_draw_cnt;
@@ -73,14 +73,14 @@ void LogText::saved_draw(sf::RenderWindow & win) {
 }
 
 // Draw loaded (by F3) snapshot (config) info
-void LogText::snapshot_draw(sf::RenderWindow & win) {
+void LogText::snapshot_draw(sf::RenderTarget & win) {
   if (m_snapshot_info_active and !loaded_snapshot_info_str.empty()) {
     textDraw.snapshot_draw(win, loaded_snapshot_info_str);
   }
 }
 
 // Welcome 
-void LogText::welcome_draw(sf::RenderWindow & win, int speed) const {
+void LogText::welcome_draw(sf::RenderTarget & win, int speed) const {
   static int frames { 0 };
 
   // Present welcome text for double time as Help would be (after F1)
@@ -93,7 +93,7 @@ void LogText::welcome_draw(sf::RenderWindow & win, int speed) const {
   }
 }
 
-void LogText::rescale_draw(sf::RenderWindow & win, float scale) const {
+void LogText::rescale_draw(sf::RenderTarget & win, float scale) const {
   textDraw.rescale_draw(win, scale);
 } 
 
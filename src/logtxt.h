@@ -65,14 +65,14 @@ struct LogText {
   void startSavedDraw(void);
   
   // Conditional draws
-  void help_draw(sf::RenderWindow & win); 
-  void speed_draw(sf::RenderWindow & win, int speed);
-  void snapshot_draw(sf::RenderWindow & win); 
-  void saved_draw(sf::RenderWindow & win); 
+  void help_draw(sf::RenderTarget & win); 
+  void speed_draw(sf::RenderTarget & win, int speed);
+  void snapshot_draw(sf::RenderTarget & win); 
+  void saved_draw(sf::RenderTarget & win); 
   
   // Dispatch draw
-  void welcome_draw(sf::RenderWindow & win, int speed) const; 
-  void rescale_draw(sf::RenderWindow & win, float scale) const; 
+  void welcome_draw(sf::RenderTarget & win, int speed) const; 
+  void rescale_draw(sf::RenderTarget & win, float scale) const; 
   
 private:
   std::string search_file_path(void);
@@ -13,6 +13,16 @@
 #include "opt_lyra.h"
 #include "garbage_coll.h"
 #include "fluctuate.h"
+#include "stem_batch.h"
+#include "elem_store.h"
+#include "traverse.h"
+#include "pipeline.h"
+#include "frame_output.h"
+#include "poster.h"
+#include "profiler.h"
+#include "scheduler.h"
+#include "bench.h"
+#include "aux_func.h"
 #include <cassert>
 #include <iostream>
 #include <optional>
@@ -20,8 +30,173 @@
 #include <SFML/Window/Event.hpp>
 #include <SFML/Window/Keyboard.hpp>
 
-bool recurance_elements_redraw(Element * const prim_ptr, const long level, 
-                sf::RenderWindow & win, const MovFluctuate & algo_anim, AutoScale & autoScale);
+void frame_pacing(long drawn_cnt, long culled_cnt, FrameScheduler * scheduler);
+
+
+// Computing frames and drawing them to output (window or offscreen one,
+// see frame_output.h) - until output is closed
+struct FrameLoop {
+  FrameLoop(MainProgAggr & aggr, Element & prim, ElemStore & store,
+            AutoScale & rescale, FramePipeline & pipeline, FrameScheduler & scheduler)
+    : fractMain { aggr }
+    , prim_element { prim }
+    , elemStore { store }
+    , autoScale { rescale }
+    , framePipeline { pipeline }
+    , frameScheduler { scheduler }
+  {}
+
+  MainProgAggr & fractMain;
+  Element & prim_element;
+  ElemStore & elemStore;
+  AutoScale & autoScale;
+  FramePipeline & framePipeline;
+  FrameScheduler & frameScheduler;
+
+  // # of elements computed in all frames (reused frames not counted)
+  long visited() const { return m_visited; }
+  // # of frames reused (not computed - same as previous frame)
+  long reused() const { return m_reused; }
+
+  template<typename Output>
+  void run(Output & out) {
+    if (framePipeline.threaded()) {
+      // Pipelined: next frame is computed while current one is displayed;
+      // events and config change take place while pipeline thread is idle
+      start_frame(Output::cKeepRate);
+
+      while (out.open()) {
+        const FrameResult & frame { framePipeline.finish() };
+        apply_frame(frame);
+        config_step();
+
+        handle_events(out);
+
+        start_frame(Output::cKeepRate);
+
+        display_frame(out, frame);
+      }
+      // pipeline thread still busy with last frame - leave it complete
+      (void)framePipeline.finish();
+    } else {
+      while (out.open()) {
+
+        handle_events(out);
+
+        // Reconfigurate elements according to current algo and collect stems
+        start_frame(Output::cKeepRate);
+        const FrameResult & frame { framePipeline.finish() };
+        apply_frame(frame);
+
+        display_frame(out, frame);
+
+        config_step();
+      }
+    }
+  }
+
+private:
+  // Window and keyboard events
+  template<typename Output>
+  void handle_events(Output & out) {
+    ProfileScope profile { FrameProfile::phaseEvents };
+    while (const std::optional<sf::Event> event = out.pollEvent()) {
+      assert(event and "shall be non-empty event here");
+      // Window button close
+      if (event->is<sf::Event::Closed>()) {
+        out.close();
+        }
+      // Key pressed event
+      else if (const auto* keyEvent = event->getIf<sf::Event::KeyPressed>()) {
+        assert(keyEvent and "shall be non-empty keyEvent here");
+        // Close on X and Escape
+        if ((keyEvent->code == sf::Keyboard::Key::Escape) or
+           (keyEvent->code == sf::Keyboard::Key::X)) {
+          out.close();
+        } else {
+          if ((keyEvent->code == sf::Keyboard::Key::R) or 
+              (keyEvent->code == sf::Keyboard::Key::F3)) {
+            // Reset
+            prim_element.initPrimary();
+            elemStore.reset();
+            autoScale.resetAutoScale();
+          } // intentionaly lack of else, reset handling continued below
+          // Further Key decodation dispatcher
+          fractMain.key_decodation(keyEvent->code, prim_element);
+        }
+      }
+      else {
+        // Another event than window-close or keyboard, maybe mouse?
+        // Anyway igone!
+      }
+    }
+  }
+
+  // Start computing next frame from snapshot of current state
+  void start_frame(bool keepRate) {
+    frame_pacing(m_drawn_cnt, m_culled_cnt, keepRate ? &frameScheduler : nullptr);
+    // Off-screen subtrees skipped - autoscale takes Min/Max from unclipped
+    // extent pass (see ExtentPass)
+    framePipeline.start(frame_snapshot(prim_element, fractMain.movFluctuate, true));
+  }
+
+  // Take over computed frame: primary element and autoscale
+  void apply_frame(const FrameResult & frame) {
+    m_drawn_cnt = frame.visited;
+    m_culled_cnt = frame.culled;
+    if (frame.reused) {
+      ++m_reused;
+    } else {
+      m_visited += frame.visited;
+    }
+    FrameProfile::trace_nodes(frame.nodes);
+    prim_element = frame.prim;
+    autoScale.cycleStart();
+    autoScale.mergeMinMax(frame.minmax);
+    autoScale.cycleResume(prim_element);
+  }
+
+  // possible signle step change of algo due to animation or flash (light effect)
+  void config_step() {
+    ProfileScope profile { FrameProfile::phaseConfig };
+    if (!autoScale.ifRescaleActive()) {
+      fractMain.one_step_cfg_change();
+      // also possible demo generation step
+      fractMain.demoGenerator(prim_element, elemStore, autoScale);
+    }
+  }
+
+  // Draw computed frame and show it
+  template<typename Output>
+  void display_frame(Output & out, const FrameResult & frame) {
+    {
+      ProfileScope profile { FrameProfile::phaseDraw };
+      // All collected stems at once
+      out.draw(frame.batches, frame.reused);
+    }
+
+    // Light source and/or possible text info - on top of picture
+    if (sf::RenderTarget * overlay { out.overlay() }) {
+      ProfileScope profile { FrameProfile::phaseOverlay };
+      fractMain.draw_artefacts(*overlay, autoScale);
+    } else {
+      // Light still moving (e.g. demo) although not drawn
+      fractMain.move_artefacts(autoScale);
+    }
+
+    ProfileScope profile { FrameProfile::phaseDisplay };
+    out.display();
+  }
+
+  // # of elements drawn in previous frame
+  long m_drawn_cnt { 0 };
+  // # of subtrees culled in previous frame
+  long m_culled_cnt { 0 };
+  // # of elements computed in all frames
+  long m_visited { 0 };
+  // # of frames reused
+  long m_reused { 0 };
+};
 
 
 int main(int argc, const char** argv)
@@ -38,6 +213,17 @@ int main(int argc, const char** argv)
   
     // Collecting errors, warning, info (trace); also Garbage collector: memory management
     MemAndDebug dbg;
+
+    // Benchmark - the same run every time: fixed seed and initial speed,
+    // full fractal from first frame (no growing animation)
+    const BenchScenario * bench { nullptr };
+    if (!options.optBench.empty()) {
+      bench = BenchScenario::find(options.optBench);
+      assert(bench and "scenario shall be verified by options parsing");
+      myAux::fix_random_seed(BenchScenario::cSeed);
+      options.optSpeed = bench->speed;
+      options.optGrowingOff = true;
+    }
     // Auto (re)scalling
     AutoScale autoScale(!options.optAutoScaleOff);
 
@@ -45,70 +231,77 @@ int main(int argc, const char** argv)
     MainProgAggr fractMain(options);
     fractMain.postInitSync();
 
-    std::string windowName {cFrac::ProgramName};
-    if (options.optDemo) windowName = cFrac::DemoProgramName;
-
-    sf::RenderWindow window(sf::VideoMode({cFrac::WindowXsize, cFrac::WindowYsize}), 
-                            windowName);
-
     // First fractal element (order 0)
     Element prim_element;
     prim_element.initPrimary();
+    // All elements of fractal tree (primary one copied from prim_element)
+    ElemStore elemStore { options.optMemBudget, ChildKernel::select(options.optKernel) };
 
-    while (window.isOpen()) {
-
-      while (const std::optional<sf::Event> event = window.pollEvent()) {
-        assert(event and "shall be non-empty event here");
-        // Window button close
-        if (event->is<sf::Event::Closed>()) {
-          window.close();
-          }
-        // Key pressed event
-        else if (const auto* keyEvent = event->getIf<sf::Event::KeyPressed>()) {
-          assert(keyEvent and "shall be non-empty keyEvent here");
-          // Close on X and Escape
-          if ((keyEvent->code == sf::Keyboard::Key::Escape) or
-             (keyEvent->code == sf::Keyboard::Key::X)) {
-            window.close();
-          } else {
-            if ((keyEvent->code == sf::Keyboard::Key::R) or 
-                (keyEvent->code == sf::Keyboard::Key::F3)) {
-              // Reset
-              prim_element.initPrimary();
-              autoScale.resetAutoScale();
-            } // intentionaly lack of else, reset handling continued below
-            // Further Key decodation dispatcher
-            fractMain.key_decodation(keyEvent->code, prim_element);
-          }
-        }
-        else {
-          // Another event than window-close or keyboard, maybe mouse?
-          // Anyway igone!
-        }
-      }
-
-      window.clear();
-
-      autoScale.cycleStart();
+    // Frame phases traced to file (before any frame is computed)
+    if (!options.optTrace.empty()) {
+      (void)FrameProfile::trace_open(options.optTrace);
+    }
 
-      // Reconfigurate elements according to current algo and Draw in recurrence
-      (void)recurance_elements_redraw(&prim_element, 0, window, 
-                                      fractMain.movFluctuate, autoScale); // 0 - start level
+    // Walking elements (transform and draw) by given # of threads
+    ParallelWalk elementsWalk { options.optThreads, options.optLod, options.optInstance };
+    // Frames computed (possibly by own thread) from snapshot of current state
+    FramePipeline framePipeline { elemStore, elementsWalk, options.optPipeline };
 
-      autoScale.cycleResume(prim_element);
+    // Window frames paced (unless synchronized with display refresh)
+    FrameScheduler frameScheduler { options.optVsync ? 0.0 : options.optMaxFps };
+    FrameLoop frameLoop { fractMain, prim_element, elemStore, autoScale, framePipeline,
+                          frameScheduler };
+    const RasterCfg raster { options.optRaster == "cpu", options.optThreads };
 
-      // Light source and/or possible text info - on top of picture
-      fractMain.draw_artefacts(window, autoScale);
+    if (bench) {
+      // Offscreen - scripted scenario measured
+      if (bench->lightSweep) {
+        fractMain.lightS.sweep_light();
+      }
+      BenchOutput benchOutput { *bench, options.optThreads };
+      frameLoop.run(benchOutput);
+      benchOutput.report(frameLoop.visited(), frameLoop.reused());
+    } else if (!options.optPoster.empty()) {
+      // Offscreen - single snapshot exported as poster
+      const std::optional<sf::Vector2u> size { PosterExport::parse_size(options.optPosterSize) };
+      if (!size) {
+        std::cerr << "Error in command line: poster size expected as WIDTHxHEIGHT" << std::endl;
+        return 2;
+      }
+      for (int snapshot { 0 }; snapshot < options.optPosterSnapshot; ++snapshot) {
+        prim_element.initPrimary();
+        elemStore.reset();
+        autoScale.resetAutoScale();
+        fractMain.load_next_snapshot(prim_element);
+      }
+      // Growing and autoscale finished before export
+      WarmupOutput warmup { options.optFrames };
+      frameLoop.run(warmup);
 
-      window.display();
-    
-      // possible signle step change of algo due to animation or flash (light effect)
-      if (!autoScale.ifRescaleActive()) {
-        fractMain.one_step_cfg_change();
-        // also possible demo generation step
-        fractMain.demoGenerator(prim_element, autoScale);
+      PosterExport poster { options.optPoster, *size, options.optThreads };
+      if (!poster.render(elemStore, elementsWalk,
+                         frame_snapshot(prim_element, fractMain.movFluctuate, false))) {
+        return 1;
       }
+    } else if (!options.optStream.empty()) {
+      // Offscreen - frames streamed as video
+      StreamOutput streamOutput { options.optStream,
+                                  options.optStreamRgba ? StreamOutput::rgba : StreamOutput::y4m,
+                                  options.optFps, options.optFrames, raster };
+      frameLoop.run(streamOutput);
+    } else if (!options.optHeadless.empty()) {
+      // Offscreen - frames written to image files
+      ImageOutput imageOutput { options.optHeadless, options.optFrames, raster };
+      frameLoop.run(imageOutput);
+    } else {
+      std::string windowName {cFrac::ProgramName};
+      if (options.optDemo) windowName = cFrac::DemoProgramName;
+
+      WindowOutput windowOutput { windowName, options.optVsync };
+      frameLoop.run(windowOutput);
     }
+    // All frames finished - rest of trace written
+    FrameProfile::trace_close();
 
   }
   catch (const char * exception) {
@@ -125,7 +318,6 @@ int main(int argc, const char** argv)
   // std::cout << " NDEBUG !! (release mode)" << std::endl;
 #endif
 
-  // gc.release_all(); //Manually (not really needed) dynamic data cleanup
   return 0;
 }
 
@@ -11,6 +11,7 @@
 #include "config.h"
 #include "dbg_report.h"
 #include "fractal.h"
+#include "lod.h"
 #include <iostream>
 
 OptParams optParse(int argc, const char** argv)
@@ -35,7 +36,47 @@ OptParams optParse(int argc, const char** argv)
       | lyra::opt(myArgs.optSpeed, "speed")
             ["-s"]["--speed"]("Initial Speed vs Detail draw [0-20]")
       | lyra::opt(myArgs.optSnapshot, "file")
-            ["-f"]["--file"]("Snapshot File"); 
+            ["-f"]["--file"]("Snapshot File")
+      | lyra::opt(myArgs.optMemBudget, "MB")
+            ["-m"]["--membudget"]("Elements memory budget in MB (0 - no limit)")
+      | lyra::opt(myArgs.optThreads, "threads")
+            ["-t"]["--threads"]("# of drawing threads (1 by default, 0 - all cores)")
+      | lyra::opt(myArgs.optPipeline)
+            ["-p"]["--pipeline"]("Compute next frame while displaying current (Off by default)")
+      | lyra::opt(myArgs.optKernel, "kernel")
+            ["-k"]["--kernel"]("Transform kernel: auto, scalar, sse, avx2, neon (auto by default)")
+      | lyra::opt(myArgs.optHeadless, "dir")
+            ["--headless"]("Offscreen drawing - frames written as PNG files to directory")
+      | lyra::opt(myArgs.optStream, "file")
+            ["--stream"]("Offscreen drawing - frames streamed as Y4M video to file/pipe (- stdout)")
+      | lyra::opt(myArgs.optStreamRgba)
+            ["--rgba"]("Raw RGBA video stream instead of Y4M")
+      | lyra::opt(myArgs.optFps, "fps")
+            ["--fps"]("Frame rate of video stream (60 by default)")
+      | lyra::opt(myArgs.optFrames, "frames")
+            ["--frames"]("# of frames drawn in headless/stream mode (100 by default)")
+      | lyra::opt(myArgs.optRaster, "raster")
+            ["--raster"]("Headless/stream drawing: cpu or sfml - needs OpenGL context thus display server (cpu by default)")
+                .choices("sfml", "cpu")
+      | lyra::opt(myArgs.optPoster, "file")
+            ["--poster"]("Export poster (after # of --frames) as PPM image to file")
+      | lyra::opt(myArgs.optPosterSize, "WxH")
+            ["--poster-size"]("Poster resolution, e.g. 16000x13000 (8800x7200 by default)")
+      | lyra::opt(myArgs.optPosterSnapshot, "nr")
+            ["--poster-snapshot"]("# of snapshot from file drawn as poster (1 by default, 0 - initial)")
+      | lyra::opt(myArgs.optLod, "pixels")
+            ["--lod"]("Subtrees smaller than radius (up to 16) drawn as point impostors (0 - off by default)")
+      | lyra::opt(myArgs.optInstance)
+            ["--instance"]("Self-similar subtrees drawn from single instance (Off by default)")
+      | lyra::opt(myArgs.optTrace, "file")
+            ["--trace"]("Frame phases traced to file as Chrome Trace Event JSON (e.g. for Perfetto)")
+      | lyra::opt(myArgs.optBench, "scenario")
+            ["--bench"]("Deterministic headless benchmark, results as JSON: static, opening, wind, light, snapshots")
+                .choices("static", "opening", "wind", "light", "snapshots")
+      | lyra::opt(myArgs.optMaxFps, "fps")
+            ["--max-fps"]("Window frame rate (67 by default, 0 - unlimited)")
+      | lyra::opt(myArgs.optVsync)
+            ["--vsync"]("Window frames synchronized with display refresh (instead of --max-fps)"); 
 
   // Parse the program arguments:
   auto result = cli.parse({ argc, argv });
@@ -48,6 +89,29 @@ OptParams optParse(int argc, const char** argv)
       return myArgs;
   }
 
+  // Values out of range
+  if (myArgs.optFps <= 0) {
+      std::cerr << "Error in command line: fps shall be greater than 0" << std::endl;
+      myArgs.parseResult = OptParams::error;
+      return myArgs;
+  }
+  if (myArgs.optFrames < 0) {
+      std::cerr << "Error in command line: frames shall not be negative" << std::endl;
+      myArgs.parseResult = OptParams::error;
+      return myArgs;
+  }
+  if (myArgs.optMaxFps < 0) {
+      std::cerr << "Error in command line: max fps shall not be negative" << std::endl;
+      myArgs.parseResult = OptParams::error;
+      return myArgs;
+  }
+  if (myArgs.optLod > LodImpostors::cMaxSize) {
+      std::cerr << "Error in command line: lod shall not be greater than "
+                << LodImpostors::cMaxSize << std::endl;
+      myArgs.parseResult = OptParams::error;
+      return myArgs;
+  }
+
   if (showVersion) {
     std::cout << "Program: " << cFrac::ProgramName << " (" << PROJECT_STR << ')' << '\n';
     std::cout << "Version: " << cFrac::Version << "\n\n";
@@ -62,6 +126,25 @@ OptParams optParse(int argc, const char** argv)
   Dbg::report_info("Option demo : ", myArgs.optDemo);
   Dbg::report_info("Option initial speed : ", myArgs.optSpeed);
   Dbg::report_info("Option Snapshot file: " + myArgs.optSnapshot); 
+  Dbg::report_info("Option memory budget (MB): ", myArgs.optMemBudget);
+  Dbg::report_info("Option threads: ", myArgs.optThreads);
+  Dbg::report_info("Option pipeline: ", myArgs.optPipeline);
+  Dbg::report_info("Option kernel: " + myArgs.optKernel);
+  Dbg::report_info("Option headless directory: " + myArgs.optHeadless);
+  Dbg::report_info("Option stream: " + myArgs.optStream);
+  Dbg::report_info("Option stream RGBA: ", myArgs.optStreamRgba);
+  Dbg::report_info("Option fps: ", myArgs.optFps);
+  Dbg::report_info("Option frames: ", myArgs.optFrames);
+  Dbg::report_info("Option raster: " + myArgs.optRaster);
+  Dbg::report_info("Option poster: " + myArgs.optPoster);
+  Dbg::report_info("Option poster size: " + myArgs.optPosterSize);
+  Dbg::report_info("Option poster snapshot: ", myArgs.optPosterSnapshot);
+  Dbg::report_info("Option LOD impostors radius: ", static_cast<long>(myArgs.optLod));
+  Dbg::report_info("Option instancing: ", myArgs.optInstance);
+  Dbg::report_info("Option trace: " + myArgs.optTrace);
+  Dbg::report_info("Option bench: " + myArgs.optBench);
+  Dbg::report_info("Option max fps: ", static_cast<long>(myArgs.optMaxFps));
+  Dbg::report_info("Option vsync: ", myArgs.optVsync);
   
   return myArgs;
 }
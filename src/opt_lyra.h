@@ -22,6 +22,25 @@ struct OptParams {
   int optSpeed {8}; // default speed
   bool optAutoScaleOff {false};
   std::string optSnapshot {cPath::cDefaultSnapshot}; 
+  int optMemBudget {0}; // elements memory budget in MB (0 - no limit)
+  int optThreads {1}; // # of walking threads (0 - all hardware threads)
+  bool optPipeline {false}; // compute next frame while current one is displayed
+  std::string optKernel {"auto"}; // children transform kernel (see child_kernel.h)
+  std::string optHeadless {}; // directory for frame images (empty - on-screen window)
+  std::string optStream {}; // file/pipe for video stream, "-" stdout (empty - no stream)
+  bool optStreamRgba {false}; // raw RGBA video stream instead of Y4M
+  int optFps {60}; // frame rate of video stream
+  int optFrames {100}; // # of frames drawn in headless or stream mode
+  std::string optRaster {"cpu"}; // offscreen drawing: cpu or sfml (see cpu_raster.h)
+  std::string optPoster {}; // PPM file for poster export (empty - no poster, see poster.h)
+  std::string optPosterSize {"8800x7200"}; // poster resolution WIDTHxHEIGHT
+  int optPosterSnapshot {1}; // # of snapshot in snapshot file drawn as poster (0 - initial one)
+  float optLod {0.0f}; // subtrees radius (pixels) drawn by LOD impostors (0 - off, see lod.h)
+  bool optInstance {false}; // subtrees drawn from single instance (see instance.h)
+  std::string optTrace {}; // file of frame phases trace (Chrome Trace Event JSON)
+  std::string optBench {}; // benchmark scenario (empty - no benchmark, see bench.h)
+  float optMaxFps {67.0f}; // window frame rate (0 - unlimited, see scheduler.h)
+  bool optVsync {false}; // window frames synchronized with display refresh (instead of max fps)
   
   int parseResult {};
 };
@@ -0,0 +1,215 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "pipeline.h"
+#include "dbg_report.h"
+#include "profiler.h"
+#include <cassert>
+
+// Walk (compute) frame from input into result - see recurrence.cpp
+long elements_redraw(ElemStore & store, ParallelWalk & walk,
+                     FrameInput & input, FrameResult & result);
+
+
+FrameInput frame_snapshot(const Element & prim, const MovFluctuate & algo_anim, bool cull) {
+  FrameInput input { prim, algo_anim.algo_data_fluctuate, algo_anim.child_transforms(), {},
+                     FlashCtrl::current(algo_anim.ifFreezeTimeStopActive()),
+                     ColorPal::current_palettes() };
+  // Consider element size limits on going to deeper branch
+  if (algo_anim.isAnimationActive()) {
+    input.limits.smallVec = TranAlg::s_SmallVecAnim; // animation vector length threshold
+  } else {
+    input.limits.smallVec = TranAlg::s_SmallVect; // static vector length threshold
+  }
+  input.limits.reach.set(input.child_transforms, input.limits.maxOrder);
+  if (cull) {
+    WalkClip & clip { input.limits.clip };
+    clip.active = true;
+    clip.x0 = 0.0f;
+    clip.y0 = 0.0f;
+    clip.x1 = static_cast<float>(cFrac::WindowXsize);
+    clip.y1 = static_cast<float>(cFrac::WindowYsize);
+  }
+  return input;
+}
+
+
+FramePipeline::FramePipeline(ElemStore & store, ParallelWalk & walk, bool threaded)
+  : m_store { store }
+  , m_walk { walk }
+  , m_input {}
+  , m_results { FrameResult { walk.workers() }, FrameResult { walk.workers() } }
+{
+  Dbg::report_info("Frame pipeline threaded: ", threaded);
+  if (threaded) {
+    m_thread = std::thread(&FramePipeline::thread_loop, this);
+  }
+}
+
+FramePipeline::~FramePipeline() {
+  if (!threaded()) { return; }
+  {
+    std::lock_guard<std::mutex> lock { m_mtx };
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  m_thread.join();
+}
+
+
+void FramePipeline::start(const FrameInput & input) {
+  assert(!m_started and "previous frame not finished");
+  m_started = true;
+  m_reuse = unchanged(input);
+  if (m_reuse) {
+    return;
+  }
+  m_computed = true;
+  if (!threaded()) {
+    m_input = input;
+    compute();
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock { m_mtx };
+    m_input = input;
+    m_pending = true;
+  }
+  m_cv.notify_all();
+}
+
+
+FrameResult & FramePipeline::finish() {
+  ProfileScope profile { FrameProfile::phaseFinish };
+  assert(m_started and "no frame started");
+  m_started = false;
+  if (m_reuse) {
+    // front buffer is shown again
+    FrameResult & result { m_results[1 - m_back] };
+    result.reused = true;
+    return result;
+  }
+  if (threaded()) {
+    std::unique_lock<std::mutex> lock { m_mtx };
+    m_cv.wait(lock, [this] { return !m_pending; });
+  }
+  // computed buffer becomes front one
+  FrameResult & result { m_results[m_back] };
+  m_back = 1 - m_back;
+  return result;
+}
+
+
+void FramePipeline::compute() {
+  ProfileScope profile { FrameProfile::phaseWalk };
+  FrameResult & result { m_results[m_back] };
+  result.visited = elements_redraw(m_store, m_walk, m_input, result);
+  result.reused = false;
+}
+
+
+static bool same_vec(const Vec2D & v1, const Vec2D & v2) {
+  return v1.x == v2.x and v1.y == v2.y and v1.dx == v2.dx and v1.dy == v2.dy and
+         v1.originalDx == v2.originalDx and v1.originalDy == v2.originalDy;
+}
+
+static bool same_element(const Element & el1, const Element & el2) {
+  const StemFlash & s1 { el1.stem_xy };
+  const StemFlash & s2 { el2.stem_xy };
+  return el1.order == el2.order and el1.index == el2.index and el1.b_type == el2.b_type and
+         same_vec(s1.vec_xy, s2.vec_xy) and s1.x1 == s2.x1 and s1.y1 == s2.y1 and
+         s1.x2 == s2.x2 and s1.y2 == s2.y2 and s1.flash.flash_cnt == s2.flash.flash_cnt and
+         s1.flash.prev_l_angle == s2.flash.prev_l_angle;
+}
+
+static bool same_algo(const T_Fluctuate_Algo_Arr & a1, const T_Fluctuate_Algo_Arr & a2) {
+  for (std::size_t order { 0 }; order < a1.size(); ++order) {
+    for (std::size_t el { 0 }; el < a1[order].size(); ++el) {
+      const DRec & r1 { a1[order][el] };
+      const DRec & r2 { a2[order][el] };
+      if (r1.repos != r2.repos or r1.angle != r2.angle or
+          r1.angle_down != r2.angle_down or r1.scale != r2.scale) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static bool same_transforms(const T_Child_Transform_Arr & t1, const T_Child_Transform_Arr & t2) {
+  for (std::size_t order { 0 }; order < t1.size(); ++order) {
+    if (t1[order].repos != t2[order].repos or t1[order].cos_scale != t2[order].cos_scale or
+        t1[order].sin_scale != t2[order].sin_scale) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Reach is given by transformations
+static bool same_limits(const WalkLimits & l1, const WalkLimits & l2) {
+  return l1.smallVec == l2.smallVec and l1.maxOrder == l2.maxOrder and
+         l1.clip.active == l2.clip.active and l1.clip.x0 == l2.clip.x0 and
+         l1.clip.y0 == l2.clip.y0 and l1.clip.x1 == l2.clip.x1 and l1.clip.y1 == l2.clip.y1 and
+         l1.lodSize == l2.lodSize and l1.instanceOrder == l2.instanceOrder;
+}
+
+static bool same_flash(const FlashCtrl & f1, const FlashCtrl & f2) {
+  return f1.globalFlash == f2.globalFlash and f1.resetFlash == f2.resetFlash and
+         f1.lightActive == f2.lightActive and f1.lightVec == f2.lightVec and
+         f1.freezeTime == f2.freezeTime;
+}
+
+static bool same_palette(const T_Col_Palet & p1, const T_Col_Palet & p2) {
+  for (std::size_t ind { 0 }; ind < p1.size(); ++ind) {
+    if (p1[ind].begin_c != p2[ind].begin_c or p1[ind].end_c != p2[ind].end_c) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+bool FramePipeline::unchanged(const FrameInput & input) const {
+  if (!m_computed) {
+    return false;
+  }
+  // Flash effect counted down by every frame (unless time frozen)
+  const FrameResult & previous { m_results[1 - m_back] };
+  if (previous.flashes > 0 and !input.flashCtrl.freezeTime) {
+    return false;
+  }
+  return same_element(input.prim, m_input.prim) and
+         same_algo(input.algo_fluct_data, m_input.algo_fluct_data) and
+         same_transforms(input.child_transforms, m_input.child_transforms) and
+         same_limits(input.limits, m_input.limits) and
+         same_flash(input.flashCtrl, m_input.flashCtrl) and
+         same_palette(input.palettes.normal, m_input.palettes.normal) and
+         same_palette(input.palettes.flash, m_input.palettes.flash);
+}
+
+
+void FramePipeline::thread_loop() {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock { m_mtx };
+      m_cv.wait(lock, [this] { return m_stop or m_pending; });
+      if (m_stop) { return; }
+    }
+
+    compute();
+
+    {
+      std::lock_guard<std::mutex> lock { m_mtx };
+      m_pending = false;
+    }
+    m_cv.notify_all();
+  }
+}
@@ -0,0 +1,87 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "autoscale.h"
+#include "elem_store.h"
+#include "fluctuate.h"
+#include "stem_batch.h"
+#include "traverse.h"
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Geometry of single computed frame - ready for drawing
+struct FrameResult {
+  explicit FrameResult(int parts) : batches { parts } {}
+  FrameBatches batches;        // all stems vertices
+  AutoScale::VecMinMax minmax; // Min/Max of drawing
+  long visited { 0 };          // # of elements drawn
+  long culled { 0 };           // # of subtrees culled (off-screen)
+  long flashes { 0 };          // # of stems with flash effect in progress
+  T_Order_Counts nodes {};     // # of elements drawn per order
+  Element prim;                // primary element after walk
+  bool reused { false };       // not computed - same as previous frame
+};
+
+// Snapshot of everything the frame walk reads from main thread state;
+// cull - subtrees outside of window are skipped (Min/Max of whole drawing
+// still comes from unclipped extent pass)
+FrameInput frame_snapshot(const Element & prim, const MovFluctuate & algo_anim, bool cull);
+
+// Frame pipeline with double-buffered results.
+// start() hands frame input over, finish() waits for the computed frame.
+// When threaded, frame N+1 is computed by pipeline thread (into back buffer)
+// while main thread draws and displays frame N (front buffer) - then
+// the buffers are swapped. Otherwise frame is computed within start().
+// Element store shall be modified (e.g. reset) only between finish()
+// and the next start() - pipeline thread is idle then.
+// Frame is not computed again if nothing changed - input is the same as
+// of previous frame (also primary element after its walk) and no flash
+// effect is in progress: previous result is reused then.
+struct FramePipeline {
+  FramePipeline(ElemStore & store, ParallelWalk & walk, bool threaded);
+  ~FramePipeline();
+
+  // Disable copy/move - thread refers to the pipeline
+  FramePipeline(const FramePipeline &) = delete;
+  FramePipeline & operator=(const FramePipeline &) = delete;
+
+  bool threaded() const { return m_thread.joinable(); }
+
+  // Start computing next frame (previous one shall be finished)
+  void start(const FrameInput & input);
+  // Wait for frame being computed; result valid until next finish()
+  FrameResult & finish();
+
+private:
+  void compute();
+  void thread_loop();
+  // Frame of given input would be the same as the previous one
+  bool unchanged(const FrameInput & input) const;
+
+  ElemStore & m_store;
+  ParallelWalk & m_walk;
+  FrameInput m_input;  // of previous (or being computed) frame - updated by walk
+  // Front buffer (drawn) and back buffer (computed) swapped on finish()
+  std::array<FrameResult, 2> m_results;
+  int m_back { 0 };
+  bool m_computed { false }; // any frame computed (m_input valid)
+  bool m_reuse { false };    // frame started is the previous one
+
+  std::thread m_thread;
+  std::mutex m_mtx;
+  std::condition_variable m_cv;
+  bool m_pending { false }; // frame started but not computed yet
+  bool m_started { false }; // frame started but not finished yet
+  bool m_stop { false };
+};
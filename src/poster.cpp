@@ -0,0 +1,123 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "poster.h"
+#include "autoscale.h"
+#include "dbg_report.h"
+#include <algorithm>
+#include <cstdio>
+
+PosterExport::PosterExport(const std::string & file, sf::Vector2u size, int threads)
+  : m_file { file }
+  , m_size { size }
+  , m_raster { { size.x, std::min(size.y, static_cast<unsigned>(cStripHeight)) }, threads }
+  , m_rows(std::size_t { size.x } * cStripHeight * 3)
+{
+  Dbg::report_info("Poster export: " + file);
+  Dbg::report_info("Poster width: ", static_cast<long>(size.x));
+  Dbg::report_info("Poster height: ", static_cast<long>(size.y));
+}
+
+
+std::optional<sf::Vector2u> PosterExport::parse_size(const std::string & text) {
+  // Limit of side (PPM has none) - just sanity check
+  constexpr static unsigned cMaxSide { 65536 };
+  unsigned width { 0 };
+  unsigned height { 0 };
+  char rest { 0 };
+  if (std::sscanf(text.c_str(), "%ux%u%c", &width, &height, &rest) != 2) {
+    return std::nullopt;
+  }
+  if (width == 0 or height == 0 or width > cMaxSide or height > cMaxSide) {
+    return std::nullopt;
+  }
+  return sf::Vector2u { width, height };
+}
+
+
+Element PosterExport::poster_primary(const Element & prim, float factor, sf::Vector2f offset) {
+  Element poster { prim };
+  Vec2D & vec { poster.stem_xy.vec_xy };
+  vec.x = vec.x * factor + offset.x;
+  vec.y = vec.y * factor + offset.y;
+  vec.dx *= factor;
+  vec.dy *= factor;
+  // base of primary transformation (see Element::transform_vec_stem)
+  vec.originalDx *= factor;
+  vec.originalDy *= factor;
+  StemFlash & stem { poster.stem_xy };
+  stem.x1 = stem.x1 * factor + offset.x;
+  stem.y1 = stem.y1 * factor + offset.y;
+  stem.x2 = stem.x2 * factor + offset.x;
+  stem.y2 = stem.y2 * factor + offset.y;
+  return poster;
+}
+
+
+bool PosterExport::render(ElemStore & store, ParallelWalk & walk, const FrameInput & input) {
+  std::FILE * file { std::fopen(m_file.c_str(), "wb") };
+  if (file == nullptr) {
+    Dbg::report_error("Poster file can not be created: " + m_file + " ", 0);
+    return false;
+  }
+  bool written { std::fprintf(file, "P6\n%u %u\n255\n", m_size.x, m_size.y) > 0 };
+
+  // Whole window fitted into poster (centered)
+  const float factor { std::min(static_cast<float>(m_size.x) / cFrac::WindowXsize,
+                                static_cast<float>(m_size.y) / cFrac::WindowYsize) };
+  const sf::Vector2f offset { (m_size.x - factor * cFrac::WindowXsize) / 2.0f,
+                              (m_size.y - factor * cFrac::WindowYsize) / 2.0f };
+
+  FrameInput strip { input };
+  strip.flashCtrl.lightActive = false;
+  WalkClip & clip { strip.limits.clip };
+  clip.active = true;
+  clip.x0 = 0.0f;
+  clip.y0 = 0.0f;
+  clip.x1 = static_cast<float>(m_raster.size().x);
+  clip.y1 = static_cast<float>(m_raster.size().y);
+
+  FrameBatches batches { walk.workers() };
+  AutoScale::VecMinMax minmax;
+  long visited { 0 };
+  long maxPages { 0 };
+  for (unsigned top { 0 }; top < m_size.y and written; top += cStripHeight) {
+    // Strip is always at the top of its own coordinates
+    strip.prim = poster_primary(input.prim, factor, { offset.x, offset.y - top });
+    batches.clear();
+    minmax = AutoScale::cMinMaxStart;
+    visited += walk.walk(store, strip, batches, minmax);
+    maxPages = std::max(maxPages, store.pages());
+    store.reclaim_unvisited();
+
+    m_raster.clear();
+    m_raster.draw(batches);
+
+    // RGBA -> RGB rows
+    const unsigned rows { std::min(static_cast<unsigned>(cStripHeight), m_size.y - top) };
+    const std::size_t count { std::size_t { m_size.x } * rows };
+    const std::uint8_t * pixel { m_raster.pixels() };
+    for (std::size_t ind { 0 }; ind < count; ++ind, pixel += 4) {
+      m_rows[ind * 3] = pixel[0];
+      m_rows[ind * 3 +1] = pixel[1];
+      m_rows[ind * 3 +2] = pixel[2];
+    }
+    written = std::fwrite(m_rows.data(), 1, count * 3, file) == count * 3;
+  }
+  written = (std::fclose(file) == 0) and written;
+
+  if (!written) {
+    Dbg::report_error("Poster file write failed: " + m_file + " ", 0);
+    return false;
+  }
+  Dbg::report_info("Poster elements drawn (all strips): ", visited);
+  Dbg::report_info("Poster max element pages (single strip): ", maxPages);
+  return true;
+}
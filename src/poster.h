@@ -0,0 +1,73 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "cpu_raster.h"
+#include "elem_store.h"
+#include "fractal.h"
+#include "stem_batch.h"
+#include "traverse.h"
+#include <SFML/Graphics.hpp>
+#include <SFML/Window/Event.hpp>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Frames computed but not drawn - frame loop (see frame_output.h) only brings
+// animation (e.g. growing) and autoscale to their final state before export
+struct WarmupOutput {
+  explicit WarmupOutput(long frames) : m_frames { frames } {}
+
+  bool open() const { return m_frame < m_frames; }
+  void close() { m_frames = m_frame; }
+  std::optional<sf::Event> pollEvent() { return std::nullopt; }
+  void draw(const FrameBatches &, bool) {}
+  sf::RenderTarget * overlay() { return nullptr; }
+  void display() { ++m_frame; }
+  constexpr static bool cKeepRate { false };
+
+private:
+  long m_frames;
+  long m_frame { 0 };
+};
+
+// Single frame exported as poster of any resolution (e.g. 16000x13000).
+// Window drawing is scaled to fit poster and drawn by CPU rasterizer
+// strip by strip (strips of cStripHeight rows, top to bottom):
+//   - only subtrees reaching the strip are walked (see WalkClip),
+//     pages of elements outside of it are released
+//   - strip pixels are appended to binary PPM (P6) file
+// Thus memory is bounded by strip (width x cStripHeight), not by poster size.
+// Flash (transient light effect) is not drawn - the same in every strip.
+struct PosterExport {
+  // Rows of single strip
+  constexpr static int cStripHeight { 4 * CpuRaster::cTileSize };
+
+  // threads - # of rasterizing threads (0 - all hardware threads)
+  PosterExport(const std::string & file, sf::Vector2u size, int threads);
+
+  // Draw frame input (window coordinates) to poster file - false on failure
+  bool render(ElemStore & store, ParallelWalk & walk, const FrameInput & input);
+
+  // Poster size from "WIDTHxHEIGHT" text (nullopt if not valid)
+  static std::optional<sf::Vector2u> parse_size(const std::string & text);
+
+private:
+  // Primary element of window moved to poster: scaled by factor then moved by offset
+  static Element poster_primary(const Element & prim, float factor, sf::Vector2f offset);
+
+  std::string m_file;
+  sf::Vector2u m_size;
+  CpuRaster m_raster;
+  // RGB rows of single strip
+  std::vector<std::uint8_t> m_rows;
+};
@@ -0,0 +1,210 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "profiler.h"
+#include "dbg_report.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Chrome Trace Event format file written by own thread: events are
+// appended to front chunk (under short lock, storage reserved), full chunk
+// is swapped with back one and formatted/written while next is collected.
+struct TraceWriter {
+  // # of events per chunk
+  constexpr static std::size_t cChunk { 4096 };
+
+  struct Event {
+    bool counter;  // nodes per order (otherwise span of phase)
+    FrameProfile::Phase phase;
+    int tid;
+    FrameProfile::Clock::time_point begin;
+    FrameProfile::Clock::time_point end;
+    T_Order_Counts nodes;
+  };
+
+  explicit TraceWriter(std::FILE * file)
+    : m_file { file }
+    , m_start { FrameProfile::Clock::now() }
+  {
+    m_front.reserve(cChunk);
+    m_back.reserve(cChunk);
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", m_file);
+    std::fputs("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+               "\"args\":{\"name\":\"frexe\"}}", m_file);
+    m_thread = std::thread(&TraceWriter::thread_loop, this);
+  }
+
+  // Remaining events written, file closed
+  ~TraceWriter() {
+    {
+      std::lock_guard<std::mutex> lock { m_mtx };
+      m_stop = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+    write(m_front);
+    std::fputs("\n]}\n", m_file);
+    std::fclose(m_file);
+  }
+
+  // Disable copy/move - thread refers to the writer
+  TraceWriter(const TraceWriter &) = delete;
+  TraceWriter & operator=(const TraceWriter &) = delete;
+
+  void append(const Event & event) {
+    std::lock_guard<std::mutex> lock { m_mtx };
+    m_front.push_back(event);
+    // back chunk still written - front one just grows
+    if (m_front.size() >= cChunk and !m_backFull) {
+      std::swap(m_front, m_back);
+      m_backFull = true;
+      m_cv.notify_all();
+    }
+  }
+
+  // Small trace id of calling thread (in order of first event)
+  static int thread_id() {
+    static std::atomic<int> s_threads { 0 };
+    thread_local const int tid { ++s_threads };
+    return tid;
+  }
+
+private:
+  void thread_loop() {
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock { m_mtx };
+        m_cv.wait(lock, [this] { return m_stop or m_backFull; });
+        if (!m_backFull) { return; } // stop
+      }
+      write(m_back);
+      {
+        std::lock_guard<std::mutex> lock { m_mtx };
+        m_back.clear();
+        m_backFull = false;
+      }
+    }
+  }
+
+  // Timestamps in us from opening of trace
+  void write(const std::vector<Event> & events) {
+    auto us = [this](FrameProfile::Clock::time_point time) {
+      return std::chrono::duration<double, std::micro>(time - m_start).count();
+    };
+    for (const Event & event : events) {
+      if (event.counter) {
+        std::fprintf(m_file, ",\n{\"name\":\"nodes per order\",\"ph\":\"C\",\"pid\":1,"
+                     "\"tid\":%d,\"ts\":%.3f,\"args\":{", event.tid, us(event.begin));
+        for (std::size_t order { 0 }; order < event.nodes.size(); ++order) {
+          std::fprintf(m_file, "%s\"%zu\":%ld", order == 0 ? "" : ",", order, event.nodes[order]);
+        }
+        std::fputs("}}", m_file);
+      } else {
+        std::fprintf(m_file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                     "\"ts\":%.3f,\"dur\":%.3f}", FrameProfile::phase_name(event.phase),
+                     event.tid, us(event.begin), us(event.end) - us(event.begin));
+      }
+    }
+  }
+
+  std::FILE * m_file;
+  FrameProfile::Clock::time_point m_start;
+  std::vector<Event> m_front; // collected
+  std::vector<Event> m_back;  // written by thread
+  std::thread m_thread;
+  std::mutex m_mtx;
+  std::condition_variable m_cv;
+  bool m_backFull { false };
+  bool m_stop { false };
+};
+
+
+std::array<FrameProfile::History, FrameProfile::phaseEndOfPhases> FrameProfile::s_history;
+std::unique_ptr<TraceWriter> FrameProfile::s_trace;
+
+const char * FrameProfile::phase_name(Phase phase) {
+  constexpr static std::array<const char *, phaseEndOfPhases> cNames {
+    "events", "walk", "finish", "config", "draw", "overlay", "display", "sleep", "frame" };
+  return cNames[phase];
+}
+
+
+void FrameProfile::record(Phase phase, Clock::time_point begin, Clock::time_point end) {
+  History & history { s_history[phase] };
+  history.ms[history.samples % cHistory] =
+    std::chrono::duration<float, std::milli>(end - begin).count();
+  ++history.samples;
+  if (s_trace) {
+    s_trace->append({ false, phase, TraceWriter::thread_id(), begin, end, {} });
+  }
+}
+
+
+bool FrameProfile::trace_open(const std::string & file) {
+  if (!cProfileOn) {
+    Dbg::report_warning("Trace not written - profiling switched off (see profiler.h)");
+    return false;
+  }
+  std::FILE * stream { std::fopen(file.c_str(), "w") };
+  if (stream == nullptr) {
+    Dbg::report_error("Trace file can not be opened: " + file + " ", 0);
+    return false;
+  }
+  s_trace = std::make_unique<TraceWriter>(stream);
+  Dbg::report_info("Trace written to: " + file);
+  return true;
+}
+
+void FrameProfile::trace_close() {
+  s_trace.reset();
+}
+
+void FrameProfile::trace_nodes(const T_Order_Counts & nodes) {
+  if (s_trace) {
+    const Clock::time_point now { Clock::now() };
+    s_trace->append({ true, phaseFrame, TraceWriter::thread_id(), now, now, nodes });
+  }
+}
+
+
+void FrameProfile::report_summary() noexcept {
+  constexpr static std::array<int, 3> cPercentiles { 50, 95, 99 };
+
+  if (s_history[phaseFrame].samples == 0) {
+    return;
+  }
+  std::cout << "Frame phases (ms)      p50      p95      p99  (last frames)\n";
+  std::cout << std::fixed << std::setprecision(2);
+  for (int phase { 0 }; phase < phaseEndOfPhases; ++phase) {
+    const History & history { s_history[phase] };
+    const long count { std::min(history.samples, cHistory) };
+    if (count == 0) {
+      continue;
+    }
+    std::array<float, cHistory> sorted { history.ms };
+    std::sort(sorted.begin(), sorted.begin() + count);
+    std::cout << "  " << std::left << std::setw(18) << phase_name(static_cast<Phase>(phase))
+              << std::right;
+    for (int percentile : cPercentiles) {
+      // nearest rank
+      const long rank { std::max(1L, (percentile * count + 99) / 100) };
+      std::cout << std::setw(9) << sorted[rank -1];
+    }
+    std::cout << "  (" << count << ")\n";
+  }
+  std::cout << std::defaultfloat;
+}
@@ -0,0 +1,105 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "fractal.h"
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+
+// Profiling switched off/on by build (meson -Dprofile=false or
+// make PROFILE=0), on by default
+#ifndef FRACTAL_PROFILE
+#define FRACTAL_PROFILE 1
+#endif
+
+// Writer of trace file - see profiler.cpp
+struct TraceWriter;
+
+// Frame phases profiler - duration of every phase of frame is recorded
+// into fixed ring buffer (last cHistory frames, no heap allocation);
+// p50/p95/p99 of them are reported by Dbg::report_summary at exit.
+// Phases are timed by ProfileScope objects - compiled out entirely
+// if cProfileOn is switched off.
+// Every phase is recorded by single thread only (walk possibly by
+// pipeline thread, all others by main one) - history is read at exit.
+// Optionally phases are also traced: every occurrence written as span
+// of Chrome Trace Event format (JSON - e.g. for chrome://tracing or
+// Perfetto), together with # of nodes per order of every frame.
+// Trace events are buffered - file is written by own thread.
+struct FrameProfile {
+  // Switch off/on profiling by build (also in release builds)
+  constexpr static bool cProfileOn { FRACTAL_PROFILE != 0 };
+  // # of last samples kept per phase
+  constexpr static long cHistory { 1024 };
+
+  enum Phase {
+    phaseEvents,   // window and keyboard events
+    phaseWalk,     // transform and collect stems (elements_redraw)
+    phaseFinish,   // waiting for walk of frame
+    phaseConfig,   // config step, demo
+    phaseDraw,     // stems drawing (or raster)
+    phaseOverlay,  // light and text artefacts
+    phaseDisplay,  // display (shown or written)
+    phaseSleep,    // keeping frame rate
+    phaseFrame,    // whole frame - time between frames (without sleep)
+    phaseEndOfPhases
+  };
+
+  using Clock = std::chrono::steady_clock;
+
+  static const char * phase_name(Phase phase);
+
+  // Single phase occurrence
+  static void record(Phase phase, Clock::time_point begin, Clock::time_point end);
+  // Percentiles of all phases (nothing if none recorded)
+  static void report_summary() noexcept;
+
+  // Tracing to file - until trace_close() (or exit)
+  static bool trace_open(const std::string & file);
+  static void trace_close();
+  // # of nodes per order of frame (traced as counters)
+  static void trace_nodes(const T_Order_Counts & nodes);
+
+private:
+  // History of single phase (ring buffer) in ms
+  struct History {
+    std::array<float, cHistory> ms {};
+    long samples { 0 };  // all recorded (also overwritten ones)
+  };
+  static std::array<History, phaseEndOfPhases> s_history;
+  // Trace (if open) - see profiler.cpp
+  static std::unique_ptr<TraceWriter> s_trace;
+};
+
+// Time of scope recorded as phase occurrence
+struct ProfileScope {
+  explicit ProfileScope(FrameProfile::Phase phase) : m_phase { phase } {
+    if constexpr (FrameProfile::cProfileOn) {
+      m_begin = FrameProfile::Clock::now();
+    }
+  }
+  ~ProfileScope() {
+    if constexpr (FrameProfile::cProfileOn) {
+      FrameProfile::record(m_phase, m_begin, FrameProfile::Clock::now());
+    }
+  }
+
+  // Disable copy/move - single record per scope
+  ProfileScope(const ProfileScope &) = delete;
+  ProfileScope & operator=(const ProfileScope &) = delete;
+
+private:
+  // unused if profiling off
+  [[maybe_unused]] FrameProfile::Phase m_phase;
+  [[maybe_unused]] FrameProfile::Clock::time_point m_begin {};
+};
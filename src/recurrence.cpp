@@ -10,172 +10,82 @@
 #include "autoscale.h"
 #include "fractal.h"
 #include "dbg_report.h"
-#include "garbage_coll.h"
+#include "elem_store.h"
 #include "transform.h"
 #include "fluctuate.h"
-#include <SFML/Graphics/PrimitiveType.hpp>
+#include "stem_batch.h"
+#include "traverse.h"
+#include "pipeline.h"
+#include "profiler.h"
+#include "scheduler.h"
 #include <chrono>
-#include <thread>
 
-// Allocate subordinate elements/branches
-// and initialize with structural data
-bool new_elements_creation(Element * const parent_ptr, const long level)
+// Keep frame rate (if scheduler given) and report frame statistics -
+// once per frame, before next frame is started
+void frame_pacing(long drawn_cnt, long culled_cnt, FrameScheduler * scheduler)
 {
-  static unsigned long recur_funct_cnt { 0 };
+  // needed calculation of time between frames
+  static auto prev_time = std::chrono::high_resolution_clock::now();
+  
+  // Possible actions per every cycle
 
-  if (level > cFrac::NrOfOrders) { 
-    //Stop further branches
-    parent_ptr->children_down = nullptr;
-    parent_ptr->children_up = nullptr;
-    return false; // nothing more to create
+  // Smart report - Show # elemnts drawn per cycle if value is >10% change from previous
+  Dbg::report_info_by_type(Dbg::infoTypeElementsDrawnPerCycle, drawn_cnt);
+  // Smart report - # of off-screen subtrees skipped (only if culling is active)
+  if (culled_cnt > 0) {
+    Dbg::report_info_by_type(Dbg::infoTypeSubtreesCulledPerCycle, culled_cnt);
   }
 
-  if (level == 1) {
-    recur_funct_cnt = 0; // reset recurrance counter so it will count per cycle
-    Dbg::report_info("Element size(of): ", sizeof(Element) );
-  } else { ++recur_funct_cnt; }
-
-  // Warn if too much elemnts created
-  if (recur_funct_cnt >= Dbg::cCreateWarningThreshold) {
-    Dbg::report_mltpl_warning(Dbg::mltplElementsCreate, recur_funct_cnt);
+  // time between frames
+  auto next_time = std::chrono::high_resolution_clock::now();
+  double elapsed_time_ms = 
+    std::chrono::duration<double, std::milli>(next_time - prev_time).count();
+  // Smart report - time perf frame in ms if value is >10% change from previous
+  Dbg::report_info_by_type(Dbg::infoTypeTimePerFrame, elapsed_time_ms);
+  if constexpr (FrameProfile::cProfileOn) {
+    const FrameProfile::Clock::time_point end { FrameProfile::Clock::now() };
+    FrameProfile::record(FrameProfile::phaseFrame,
+      end - std::chrono::duration_cast<FrameProfile::Clock::duration>(next_time - prev_time), end);
   }
-  
-  //Setup DOWN branch
-  auto u_ptr_down_temp { std::make_unique<std::array<Element, cFrac::NrOfElements>>() };
-  parent_ptr->children_down = u_ptr_down_temp.get(); // ordinary ptr to a structure
-  // Move Unique Ptr ownership to dedicated (garbage) Collection
-  MemAndDebug::collectElementPtr(std::move(u_ptr_down_temp));
-  Dbg::count_elements(cFrac::NrOfElements);
-  short ind;
-  ind = 0;
-  for(auto it = parent_ptr->children_down->begin(); it != parent_ptr->children_down->end(); ++it ) {
-    it->order = level;
-    it->b_type = downBranch;
-    it->index = ++ind;  // 1..cFrac::NrOfElements
-    it->stem_xy.prev_l_angle = lAngleUnknown;
-    it->parent_ptr = parent_ptr; // link to already existing parent
-  }
-  
-  // Setup UP branch
-  auto&& ptr_up_temp = std::make_unique<std::array<Element, cFrac::NrOfElements>>();
-  parent_ptr->children_up = ptr_up_temp.get();  // ordinary ptr to a structure
-  // Move Unique Ptr ownership to dedicated (garbage) Collection
-  MemAndDebug::collectElementPtr(std::move(ptr_up_temp));
-  Dbg::count_elements(cFrac::NrOfElements);
-  ind = 0;
-  for(auto it = parent_ptr->children_up->begin(); it != parent_ptr->children_up->end(); ++it ) {
-    it->order = level;
-    it->b_type = upBranch;
-    it->index = ++ind;  // 1..cFrac::NrOfElements
-    it->stem_xy.prev_l_angle = lAngleUnknown;
-    it->parent_ptr = parent_ptr; // link to already existing parent
+  // Smart report - heap allocations during previous frame (expected 0 after warm-up)
+  Dbg::report_info_by_type(Dbg::infoTypeAllocationsPerFrame, Dbg::frame_allocations());
+
+  // Next frame started at its deadline
+  if (scheduler) {
+    scheduler->wait();
+    // Smart report - # of frames started late (so far)
+    if (scheduler->paced()) {
+      Dbg::report_info_by_type(Dbg::infoTypeMissedDeadlines, scheduler->missed());
+    }
   }
-  
-  return true; // something created
- 
+  // Omit obove delay for inter frame time calculation
+  prev_time = std::chrono::high_resolution_clock::now();
 }
 
 
-bool recurance_elements_redraw(Element * const parent_ptr, const long level, 
-           sf::RenderWindow &win, const MovFluctuate &algo_anim,
-           AutoScale & autoscale)
+// Reconfigurate all elements according to frame input (algo snapshot)
+// and collect them for drawing - once per frame, possibly by pipeline thread
+long elements_redraw(ElemStore & store, ParallelWalk & walk,
+                     FrameInput & input, FrameResult & result)
 {
-  static long recur_funct_cnt { 0 };
+  result.batches.clear();
+  result.minmax = AutoScale::cMinMaxStart;
 
-  // needed calculation of time between frames
-  static auto prev_time = std::chrono::high_resolution_clock::now();
-  
-  if (level == 0) {
-    // Possible actions per every cycle
-
-    // Smart report - Show # elemnts drawn per cycle if value is >10% change from previous
-    Dbg::report_info_by_type(Dbg::infoTypeElementsDrawnPerCycle, recur_funct_cnt); //report o
-    recur_funct_cnt = 0; // reset recurrance counter so it will count per cycle
+  // Tranform every element (base on parent one),
+  // find drawing Min/Max and collect element for drawing
+  const long drawn_cnt { walk.walk(store, input, result.batches, result.minmax) };
+  result.prim = input.prim;
+  result.culled = walk.culled();
+  result.flashes = walk.flashes();
+  result.nodes = walk.nodes();
 
-    // time between frames
-    auto next_time = std::chrono::high_resolution_clock::now();
-    double elapsed_time_ms = 
-      std::chrono::duration<double, std::milli>(next_time - prev_time).count();
-    // Smart report - time perf frame in ms if value is >10% change from previous
-    Dbg::report_info_by_type(Dbg::infoTypeTimePerFrame, elapsed_time_ms);
-
-    // Ensure minimal time between consecutive frame drawing
-    long correctionTime { 0 };
-    if (elapsed_time_ms < cFrac::MinTimePerFrame) {
-      correctionTime = cFrac::MinTimePerFrame - elapsed_time_ms;
-      std::this_thread::sleep_for(std::chrono::milliseconds(correctionTime));
-    }
-    // Omit obove delay for inter frame time calculation
-    prev_time = std::chrono::high_resolution_clock::now();
-  
-  } else {
-    // action on non-first call
-    ++recur_funct_cnt;
-  }
+  // Prune subtrees no longer visited
+  store.reclaim();
 
   // Warn if too much elemnts drawed per cycle
-  if (recur_funct_cnt >= Dbg::cDrawWarningThreshold) {
-    Dbg::report_mltpl_warning(Dbg::mltplElementsDraw, recur_funct_cnt);
-    // return false; // with active return object drawing is aborted
+  if (drawn_cnt >= Dbg::cDrawWarningThreshold) {
+    Dbg::report_mltpl_warning(Dbg::mltplElementsDraw, drawn_cnt);
   }
 
-  // Tranform this vector (base on settings copied from parent) to the new one 
-  parent_ptr->transform_vec_stem(algo_anim.algo_data_fluctuate);
-
-  autoscale.findMinMax(parent_ptr->stem_xy.vec_xy);
-
-  // Draw the element
-  parent_ptr->stem_xy.draw_stem(win, level, algo_anim.ifFreezeTimeStopActive());
-
-  if (level > cFrac::NrOfOrders) { 
-    return false; // no more branches to scan
-  }
-
-  // Take approx vector length : |dx| + |dy| ~ sqrt(dx2 + dy2)
-  auto approx_vec =  std::abs(parent_ptr->stem_xy.vec_xy.dx) + 
-                     std::abs(parent_ptr->stem_xy.vec_xy.dy); 
-  
-  // Consider element size limits on going to deeper branch
-  // If size below threshold do not continue with children
-  if (algo_anim.isAnimationActive()) {
-    if (approx_vec < TranAlg::s_SmallVecAnim) { // animation vector length threshold
-      return false; // do not go deeper 
-      }
-  } else {
-    if (approx_vec < TranAlg::s_SmallVect) { // static vector length threshold
-      return false; // do not go deeper 
-    }
-  }  
-
-   assert((parent_ptr->children_down != nullptr and
-           parent_ptr->children_up != nullptr )
-      or  (parent_ptr->children_down == nullptr and
-           parent_ptr->children_up == nullptr ));
-  
-  // if needed - create next subordinate braches level starting from current branch
-  if (parent_ptr->children_down == nullptr) {
-    auto success = new_elements_creation(parent_ptr, level +1);
-    if (!success) {
-      return false;
-    }
-  }
-
-  // Follow DOWN branch
-  for(auto it = parent_ptr->children_down->begin(); it != parent_ptr->children_down->end(); ++it ) {
-    // Traverse next level
-    // Propagate (copy) parent position/vector to child (vec_xy is overriten!)
-    it->stem_xy.vec_xy = parent_ptr->stem_xy.vec_xy; 
-    recurance_elements_redraw(it, level+1, win, algo_anim, autoscale);
-  }
-  
-  // Follow UP branch
-  for(auto it = parent_ptr->children_up->begin(); it != parent_ptr->children_up->end(); ++it ) {
-    // Traverse next level
-    // Propagate (copy) parent position/vector to child (vec_xy is overriten!)
-    it->stem_xy.vec_xy = parent_ptr->stem_xy.vec_xy; 
-    recurance_elements_redraw(it, level+1, win, algo_anim, autoscale);
-  }
-  
-  return true; // recurance continue
- 
+  return drawn_cnt;
 }
@@ -0,0 +1,51 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "scheduler.h"
+#include "dbg_report.h"
+#include "profiler.h"
+#include <thread>
+
+FrameScheduler::FrameScheduler(double fps)
+  : m_period { fps > 0.0
+               ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / fps))
+               : Clock::duration::zero() }
+{
+  Dbg::report_info("Init: FrameScheduler (period us) ",
+                   std::chrono::duration_cast<std::chrono::microseconds>(m_period).count());
+}
+
+void FrameScheduler::wait() {
+  if (!paced()) {
+    return;
+  }
+  const Clock::time_point now { Clock::now() };
+  if (!m_started) {
+    // schedule starts with first frame
+    m_started = true;
+    m_deadline = now + m_period;
+    return;
+  }
+  if (now > m_deadline) {
+    // frame took longer than period - start next one immediately
+    ++m_missed;
+    m_deadline = now + m_period;
+    return;
+  }
+
+  ProfileScope profile { FrameProfile::phaseSleep };
+  if (m_deadline - now > cSpinTime) {
+    std::this_thread::sleep_until(m_deadline - cSpinTime);
+  }
+  while (Clock::now() < m_deadline) {
+    std::this_thread::yield();
+  }
+  m_deadline += m_period;
+}
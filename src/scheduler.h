@@ -0,0 +1,42 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include <chrono>
+
+// Frame scheduler - frames started at absolute deadlines of fixed period,
+// so truncated or overshooting sleeps do not accumulate (no drift).
+// Waiting is hybrid: sleep till shortly before deadline (sleep may
+// overshoot on loaded host) then spin till deadline.
+// Frame finished after its deadline is missed: counted (reported by
+// frame_pacing), next deadline is taken from now (no burst of frames
+// catching up).
+struct FrameScheduler {
+  using Clock = std::chrono::steady_clock;
+
+  // fps - target frame rate (0 - unpaced, e.g. frames paced by vsync)
+  explicit FrameScheduler(double fps);
+
+  bool paced() const { return m_period > Clock::duration::zero(); }
+  // # of frames finished after their deadline
+  long missed() const { return m_missed; }
+  // Wait till start of next frame
+  void wait();
+
+private:
+  // Rest of waiting (before deadline) done by spinning
+  constexpr static std::chrono::microseconds cSpinTime { 1500 };
+
+  Clock::duration m_period;
+  Clock::time_point m_deadline; // start of next frame
+  bool m_started { false };     // deadline valid (first frame waited for)
+  long m_missed { 0 };          // # of frames finished after deadline
+};
@@ -0,0 +1,91 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "stem_batch.h"
+#include "dbg_report.h"
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+#include <cassert>
+
+// Grow storage geometrically (at least doubled) to fit required # of vertices
+void VertexArena::grow(std::size_t required) {
+  std::size_t new_size { std::max({required, 2 * m_storage.size(), cInitialVertices}) };
+  m_storage.resize(new_size);
+  Dbg::report_info("Vertex arena grown to (vertices): ", static_cast<long>(new_size));
+}
+
+// Prepare for new frame - arenas keep their storage
+void StemBatch::clear() {
+  for (auto & batch : m_vertices) {
+    batch.reset();
+  }
+}
+
+// Single gradient line from begin to end point
+void StemBatch::append_line(BatchType type, sf::Vector2f from, sf::Vector2f to,
+                            sf::Color color_from, sf::Color color_to) {
+  assert(type == batchLines or type == batchFlashLines);
+  sf::Vertex * line { m_vertices[type].allocate(2) };
+  line[0] = sf::Vertex{from, color_from};
+  line[1] = sf::Vertex{to, color_to};
+}
+
+// Single gradient filled triangle: two base points and a top point
+void StemBatch::append_triangle(sf::Vector2f base1, sf::Vector2f top, sf::Vector2f base2,
+                                sf::Color color_base, sf::Color color_top) {
+  sf::Vertex * triangle { m_vertices[batchTriangles].allocate(3) };
+  triangle[0] = sf::Vertex{base1, color_base};
+  triangle[1] = sf::Vertex{top, color_top};
+  triangle[2] = sf::Vertex{base2, color_base};
+}
+
+// Draw all batches - single draw call per (non empty) batch
+void StemBatch::flush(sf::RenderTarget & win) const {
+  for (size_t type {0}; type < batchEndOfTypes; ++type) {
+    flush(win, static_cast<BatchType>(type));
+  }
+}
+
+void StemBatch::flush(sf::RenderTarget & win, BatchType type) const {
+  if (!m_vertices[type].empty()) {
+    win.draw(m_vertices[type].data(), m_vertices[type].size(), cBatchPrimitives[type]);
+  }
+}
+
+std::size_t StemBatch::vertex_count() const {
+  std::size_t count {0};
+  for (const auto & batch : m_vertices) {
+    count += batch.size();
+  }
+  return count;
+}
+
+
+void FrameBatches::clear() {
+  for (auto & part : m_parts) {
+    part.clear();
+  }
+}
+
+void FrameBatches::flush(sf::RenderTarget & win) const {
+  for (size_t type {0}; type < StemBatch::batchEndOfTypes; ++type) {
+    for (const auto & part : m_parts) {
+      part.flush(win, static_cast<StemBatch::BatchType>(type));
+    }
+  }
+}
+
+std::size_t FrameBatches::vertex_count() const {
+  std::size_t count {0};
+  for (const auto & part : m_parts) {
+    count += part.vertex_count();
+  }
+  return count;
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "fractal.h"
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// Stem colors of all orders - see colors.h
+struct StemPalettes;
+
+// Persistent vertex storage reused from frame to frame.
+// Storage is grown geometrically (only when more vertices are needed
+// than ever before) and just reset on new frame, so after warm-up
+// collecting vertices performs no heap allocations.
+struct VertexArena {
+  // Drop content of previous frame, keep the storage
+  void reset() { m_used = 0; }
+
+  // Reserve next # of vertices; returned pointer valid till next allocate/reset
+  sf::Vertex * allocate(std::size_t count) {
+    if (m_used + count > m_storage.size()) {
+      grow(m_used + count);
+    }
+    sf::Vertex * vertices { m_storage.data() + m_used };
+    m_used += count;
+    return vertices;
+  }
+
+  const sf::Vertex * data() const { return m_storage.data(); }
+  std::size_t size() const { return m_used; }
+  bool empty() const { return m_used == 0; }
+  std::size_t capacity() const { return m_storage.size(); }
+
+private:
+  // Initial storage size (# of vertices)
+  constexpr static std::size_t cInitialVertices { 1 << 16 };
+
+  void grow(std::size_t required);
+
+  std::vector<sf::Vertex> m_storage;
+  std::size_t m_used { 0 };
+};
+
+// Frame-level collection of all stems vertices.
+// Stems are appended during elements traversal
+// and drawn at the end of frame with one draw call per primitive batch
+// (instead of one draw call per stem).
+struct StemBatch {
+
+  // Separate batches - each one drawn with single primitive type
+  enum BatchType {
+    batchTriangles,   // filled (flash) triangles of orders <= 2
+    batchLines,       // ordinary stems, also empty triangles of orders <= 2
+    batchFlashLines,  // double/triple line flash stems of orders > 2
+    batchPoints,      // LOD impostors of small subtrees (see lod.h)
+    batchEndOfTypes
+  };
+
+  // Prepare for new frame (vertex data of previous frame dropped, storage kept)
+  void clear();
+
+  // Single gradient line from begin to end point
+  void append_line(BatchType type, sf::Vector2f from, sf::Vector2f to,
+                   sf::Color color_from, sf::Color color_to);
+
+  // Single point (pixel)
+  void append_point(sf::Vector2f pos, sf::Color color) {
+    *m_vertices[batchPoints].allocate(1) = sf::Vertex{pos, color};
+  }
+
+  // Single gradient filled triangle: two base points and a top point
+  void append_triangle(sf::Vector2f base1, sf::Vector2f top, sf::Vector2f base2,
+                       sf::Color color_base, sf::Color color_top);
+
+  // Whole stem of given order in ordinary or Flash version (see draw.cpp);
+  // thickness points are used only for orders <= 2
+  void append_stem(long order, bool flashing, float x, float y, float dx, float dy,
+                   const ThickPoints & thick, const StemPalettes & palettes);
+
+  // Draw all batches - triangles first so lines stay on top of them
+  void flush(sf::RenderTarget & win) const;
+  // Draw batch of single type only
+  void flush(sf::RenderTarget & win, BatchType type) const;
+
+  // Total # of vertices collected in current frame
+  std::size_t vertex_count() const;
+
+  // Vertices of single batch (e.g. for CPU rasterizer - see cpu_raster.h)
+  const VertexArena & vertices(BatchType type) const { return m_vertices[type]; }
+
+  // Primitive type used for drawing of given batch
+  constexpr static std::array<sf::PrimitiveType, batchEndOfTypes> cBatchPrimitives {
+    sf::PrimitiveType::Triangles, sf::PrimitiveType::Lines, sf::PrimitiveType::Lines,
+    sf::PrimitiveType::Points };
+
+private:
+
+  std::array<VertexArena, batchEndOfTypes> m_vertices;
+};
+
+// Frame batches collected in parallel - separate StemBatch part per walking thread
+struct FrameBatches {
+  explicit FrameBatches(int parts) : m_parts(parts) {}
+
+  StemBatch & part(int ind) { return m_parts[ind]; }
+  const StemBatch & part(int ind) const { return m_parts[ind]; }
+  int parts() const { return static_cast<int>(m_parts.size()); }
+
+  void clear();
+  // Draw batches of all parts type by type (triangles of all parts first)
+  void flush(sf::RenderTarget & win) const;
+  std::size_t vertex_count() const;
+
+private:
+  std::vector<StemBatch> m_parts;
+};
@@ -73,7 +73,7 @@ bool TextDraw::replace_home_alias(std::string & path) {
     return false;
 }
   
-void TextDraw::help_draw(sf::RenderWindow &win) const {
+void TextDraw::help_draw(sf::RenderTarget &win) const {
   const static std::string help_text { "<F1> - Help \n"
     " Arrows - to move/change light:\n"
     " Up or W - Light color rotation\n"
@@ -112,7 +112,7 @@ void TextDraw::help_draw(sf::RenderWindow &win) const {
   }
 }
 
-void TextDraw::welcome_draw(sf::RenderWindow &win, int speed) const {
+void TextDraw::welcome_draw(sf::RenderTarget &win, int speed) const {
   if (m_font_loaded) {
     std::stringstream text_ss;;
     text_ss << "F1 for help\n";
@@ -127,7 +127,7 @@ void TextDraw::welcome_draw(sf::RenderWindow &win, int speed) const {
   }
 }
 
-void TextDraw::speed_draw(sf::RenderWindow &win, int speed) const {
+void TextDraw::speed_draw(sf::RenderTarget &win, int speed) const {
   if (m_font_loaded) {
     std::stringstream text_ss;;
     text_ss << "Speed scale - " << speed;
@@ -142,7 +142,7 @@ void TextDraw::speed_draw(sf::RenderWindow &win, int speed) const {
 }
 
 
-void TextDraw::snapshot_draw(sf::RenderWindow &win, std::string & info) const {
+void TextDraw::snapshot_draw(sf::RenderTarget &win, std::string & info) const {
   if (m_font_loaded) {
     sf::Text text(m_font, info, 20);
     text.setStyle(sf::Text::Regular);
@@ -154,7 +154,7 @@ void TextDraw::snapshot_draw(sf::RenderWindow &win, std::string & info) const {
   }
 }
 
-void TextDraw::saved_draw(sf::RenderWindow &win) const {
+void TextDraw::saved_draw(sf::RenderTarget &win) const {
   if (m_font_loaded) {
     sf::Text text(m_font, "[Saved]", 20);
     text.setStyle(sf::Text::Regular);
@@ -167,7 +167,7 @@ void TextDraw::saved_draw(sf::RenderWindow &win) const {
 }
 
 
-void TextDraw::rescale_draw(sf::RenderWindow & win, float scale) const {
+void TextDraw::rescale_draw(sf::RenderTarget & win, float scale) const {
   constexpr static int cFontSize { 20 };
   if (m_font_loaded) {
     // Convert to percentage
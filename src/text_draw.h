@@ -28,12 +28,12 @@ struct TextDraw {
   }
 
   // Real draw
-  void help_draw(sf::RenderWindow & win) const; 
-  void welcome_draw(sf::RenderWindow & win, int speed) const; 
-  void speed_draw(sf::RenderWindow & win, int speed) const; 
-  void saved_draw(sf::RenderWindow & win) const; 
-  void snapshot_draw(sf::RenderWindow & win, std::string & info) const; 
-  void rescale_draw(sf::RenderWindow & win, float scale) const; 
+  void help_draw(sf::RenderTarget & win) const; 
+  void welcome_draw(sf::RenderTarget & win, int speed) const; 
+  void speed_draw(sf::RenderTarget & win, int speed) const; 
+  void saved_draw(sf::RenderTarget & win) const; 
+  void snapshot_draw(sf::RenderTarget & win, std::string & info) const; 
+  void rescale_draw(sf::RenderTarget & win, float scale) const; 
 
   // Helper
   // Replace (possible) $HOME alias with explicit path
@@ -0,0 +1,118 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "thread_pool.h"
+#include "dbg_report.h"
+#include <cassert>
+
+ThreadPool::ThreadPool(int workers) {
+  if (workers <= 0) {
+    workers = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  if (workers <= 0) { workers = 1; } // unknown concurrency
+  Dbg::report_info("Thread pool workers: ", workers);
+
+  for (int w { 0 }; w < workers; ++w) {
+    m_ranges.push_back(std::make_unique<TaskRange>());
+  }
+  // calling thread is worker 0
+  for (int w { 1 }; w < workers; ++w) {
+    m_threads.emplace_back(&ThreadPool::worker_loop, this, w);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock { m_mtx };
+    m_stop = true;
+  }
+  m_startCv.notify_all();
+  for (auto & thread : m_threads) {
+    thread.join();
+  }
+}
+
+
+void ThreadPool::run_tasks(long count) {
+  // Contiguous range of tasks per worker
+  const long workers { static_cast<long>(m_ranges.size()) };
+  for (long w { 0 }; w < workers; ++w) {
+    std::lock_guard<std::mutex> lock { m_ranges[w]->mtx };
+    m_ranges[w]->front = count * w / workers;
+    m_ranges[w]->back = count * (w +1) / workers;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock { m_mtx };
+    m_busy = static_cast<int>(m_threads.size());
+    ++m_generation;
+  }
+  m_startCv.notify_all();
+
+  work(0);
+
+  // Wait for all workers - also for those still finishing their last task
+  std::unique_lock<std::mutex> lock { m_mtx };
+  m_doneCv.wait(lock, [this] { return m_busy == 0; });
+}
+
+
+void ThreadPool::worker_loop(int worker) {
+  long seen { 0 };
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock { m_mtx };
+      m_startCv.wait(lock, [this, seen] { return m_stop or m_generation != seen; });
+      if (m_stop) { return; }
+      seen = m_generation;
+    }
+
+    work(worker);
+
+    bool last { false };
+    {
+      std::lock_guard<std::mutex> lock { m_mtx };
+      last = (--m_busy == 0);
+    }
+    if (last) { m_doneCv.notify_one(); }
+  }
+}
+
+
+void ThreadPool::work(int worker) {
+  long task;
+  while (pop_own(worker, task) or steal(worker, task)) {
+    m_task(m_ctx, task, worker);
+  }
+}
+
+bool ThreadPool::pop_own(int worker, long & task) {
+  TaskRange & range { *m_ranges[worker] };
+  std::lock_guard<std::mutex> lock { range.mtx };
+  if (range.front < range.back) {
+    task = range.front++;
+    return true;
+  }
+  return false;
+}
+
+// Steal from back (the furthest from victim current task)
+bool ThreadPool::steal(int worker, long & task) {
+  const int workers { static_cast<int>(m_ranges.size()) };
+  for (int step { 1 }; step < workers; ++step) {
+    TaskRange & range { *m_ranges[(worker + step) % workers] };
+    std::lock_guard<std::mutex> lock { range.mtx };
+    if (range.front < range.back) {
+      task = --range.back;
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,75 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool of worker threads executing batch of tasks 0..count-1 (per frame).
+// Tasks are split into contiguous ranges - one per worker. Worker takes
+// tasks from front of its own range; when it is empty it steals from back
+// of ranges of other workers (work-stealing), so uneven tasks (subtrees)
+// are balanced. Calling thread works too (as worker 0).
+// Running tasks performs no heap allocation.
+struct ThreadPool {
+  // # of workers including calling thread; 0 - all hardware threads
+  explicit ThreadPool(int workers);
+  ~ThreadPool();
+
+  // Disable copy/move - threads refer to the pool
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool & operator=(const ThreadPool &) = delete;
+
+  int workers() const { return static_cast<int>(m_ranges.size()); }
+
+  // Execute task(long task, int worker) for all tasks 0..count-1;
+  // returns when all of them are done
+  template<typename Task>
+  void run(long count, Task & task) {
+    m_task = [](void * ctx, long t, int worker) { (*static_cast<Task *>(ctx))(t, worker); };
+    m_ctx = &task;
+    run_tasks(count);
+  }
+
+private:
+  // Tasks (still) to be done by single worker: front..back-1
+  struct TaskRange {
+    std::mutex mtx;
+    long front { 0 };
+    long back { 0 };
+  };
+
+  void run_tasks(long count);
+  void worker_loop(int worker);
+  // Execute tasks until none left in any range
+  void work(int worker);
+  bool pop_own(int worker, long & task);
+  bool steal(int worker, long & task);
+
+  std::vector<std::unique_ptr<TaskRange>> m_ranges;
+  std::vector<std::thread> m_threads;
+
+  // Current batch of tasks (type erased, no allocation)
+  void (*m_task)(void *, long, int) { nullptr };
+  void * m_ctx { nullptr };
+
+  // Batch start/finish signaling
+  std::mutex m_mtx;
+  std::condition_variable m_startCv;
+  std::condition_variable m_doneCv;
+  long m_generation { 0 };
+  int m_busy { 0 };  // # of worker threads still working on current batch
+  bool m_stop { false };
+};
@@ -36,7 +36,7 @@ void Element::initPrimary() {
   stem_xy.y1 = stem_xy.vec_xy.y - cFrac::PrimStemWidth; 
   stem_xy.y2 = stem_xy.vec_xy.y + cFrac::PrimStemWidth; 
   // prevent initial angle change
-  stem_xy.prev_l_angle = lAngleUnknown;
+  stem_xy.flash.prev_l_angle = lAngleUnknown;
 }
 
 
@@ -74,14 +74,6 @@ struct TranAlg {
 
   int get_speedScale() const;
 
-private:
-
-  int m_speedScale;
-
-  // Speed vs Detailed drawing scale
-  // speed to small vector size calculation
-  void speedScaleVerify(void);
-
   // Speed scale data - small vector sizes threshold (to be drawn)
   constexpr static int SpeedScaleDataSize = 21;
   constexpr static std::array<float, SpeedScaleDataSize> SpeedScalaData = {
@@ -108,6 +100,14 @@ private:
     10 // 20.  - 10 points
   };
 
+private:
+
+  int m_speedScale;
+
+  // Speed vs Detailed drawing scale
+  // speed to small vector size calculation
+  void speedScaleVerify(void);
+
   // Convert Symmetrical algo to working copy of (potentialy) Asymmetrical
   // and with diffrent granularity
   T_Algo_Arr conv_to_assym(T_Algo_Arr_Symm symm_algo);
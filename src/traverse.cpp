@@ -0,0 +1,194 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "traverse.h"
+#include <algorithm>
+#include <cassert>
+
+// Subtree of element: its own stem and subtrees of children; child base
+// lies at repos * vector from element base and child vector is scaled
+// by |(cos, sin) * scale| - reach computed from the highest order down
+void SubtreeReach::set(const T_Child_Transform_Arr & child_transforms, long maxOrder) {
+  factor.fill(1.0f);
+  for (long order { maxOrder -1 }; order >= 0; --order) {
+    const ChildTransforms & rules { child_transforms[order +1] };
+    float order_factor { 1.0f };
+    for (std::size_t child { 0 }; child < rules.repos.size(); ++child) {
+      const float scale { std::hypot(rules.cos_scale[child], rules.sin_scale[child]) };
+      order_factor = std::max(order_factor,
+                              std::abs(rules.repos[child]) + scale * factor[order +1]);
+    }
+    factor[order] = order_factor;
+  }
+}
+
+
+float SubtreeReach::radius(float dx, float dy, long order) const {
+  // Stem thickness (in fraction of vector) and anti-aliased/flash lines (pixels)
+  constexpr static float cThickMargin { 0.1f };
+  constexpr static float cPixelMargin { 2.0f };
+  return (factor[order] + cThickMargin) * std::hypot(dx, dy) + cPixelMargin;
+}
+
+
+bool WalkClip::outside(float x, float y, float radius) const {
+  // Distance from circle center to the nearest point of rectangle
+  const float distX { std::max({x0 - x, 0.0f, x - x1}) };
+  const float distY { std::max({y0 - y, 0.0f, y - y1}) };
+  return distX * distX + distY * distY > radius * radius;
+}
+
+
+// Stems of instance moved by root vector - pruned (by smallVec, clip or LOD)
+// exactly as walk would do with elements of store
+void DrawPass::draw_instance(float x, float y, float dx, float dy) const {
+  constexpr static ThickPoints cNoThick {};
+  const std::vector<SubtreeInstance::Stem> & stems { instance.stems() };
+  for (std::size_t ind { 0 }; ind < stems.size(); ) {
+    const SubtreeInstance::Stem & stem { stems[ind] };
+    const float sx { x + stem.x * dx - stem.y * dy };
+    const float sy { y + stem.x * dy + stem.y * dx };
+    const float sdx { stem.dx * dx - stem.dy * dy };
+    const float sdy { stem.dx * dy + stem.dy * dx };
+    if (limits.clip.active and
+        limits.clip.outside(sx, sy, limits.reach.radius(sdx, sdy, stem.order))) {
+      ++counts.culled;
+      ind += stem.skip; // whole subtree not visible
+      continue;
+    }
+    ++counts.instanced;
+    ++counts.nodes[stem.order];
+    // no flash without light - see FlashState::step
+    batch.append_stem(stem.order, false, sx, sy, sdx, sdy, cNoThick, palettes);
+
+    if (std::abs(sdx) + std::abs(sdy) < limits.smallVec) {
+      ind += stem.skip;
+    } else if (limits.impostor(sdx, sdy, stem.order)) {
+      draw_impostor(sx, sy, sdx, sdy, stem.order);
+      ind += stem.skip;
+    } else {
+      ++ind; // children (if any) follow
+    }
+  }
+}
+
+
+// Upper bound of vector length of elements of order: primary vector
+// scaled by the biggest child scale of every order
+static float max_length(const ElemStore::Page & prim,
+                        const T_Child_Transform_Arr & child_transforms, long order) {
+  float length { std::hypot(prim.dx[0], prim.dy[0]) };
+  for (long child_order { 1 }; child_order <= order; ++child_order) {
+    const ChildTransforms & rules { child_transforms[child_order] };
+    float scale { 0.0f };
+    for (std::size_t child { 0 }; child < rules.repos.size(); ++child) {
+      scale = std::max(scale, std::hypot(rules.cos_scale[child], rules.sin_scale[child]));
+    }
+    length *= scale;
+  }
+  return length;
+}
+
+
+ParallelWalk::ParallelWalk(int threads, float lodSize, bool instancing)
+  : m_pool { threads }
+  , m_impostors { lodSize }
+  , m_instancing { instancing }
+  , m_walks(m_pool.workers())
+  , m_visited(m_pool.workers())
+  , m_drawCounts(m_pool.workers())
+{
+  long roots { 1 };
+  for (long order { 0 }; order < cSplitOrder; ++order) {
+    roots *= ElemStore::cChildren;
+  }
+  m_roots.reserve(roots);
+}
+
+
+long ParallelWalk::walk(ElemStore & store, FrameInput & input, FrameBatches & batches,
+                        AutoScale::VecMinMax & minmax) {
+  assert(batches.parts() == workers());
+  Element & prim { input.prim };
+  const T_Fluctuate_Algo_Arr & algo_fluct_data { input.algo_fluct_data };
+  const T_Child_Transform_Arr & child_transforms { input.child_transforms };
+  WalkLimits limits { input.limits };
+  long visited { 0 };
+
+  // Stems of impostors have no flash effect - walked while light is active
+  if (m_impostors.active() and !input.flashCtrl.lightActive) {
+    limits.lodSize = m_impostors.size();
+    m_impostors.update(child_transforms, limits.reach, input.palettes, limits.maxOrder,
+                       limits.smallVec);
+  }
+
+  store.load_primary(prim, algo_fluct_data);
+  const ElemPos root { &store.page(0, 0), 0, 0 };
+
+  if (m_instancing and !input.flashCtrl.lightActive and cInstanceOrder < limits.maxOrder) {
+    limits.instanceOrder = cInstanceOrder;
+    m_instance.update(child_transforms, cInstanceOrder, limits.maxOrder,
+                      max_length(*root.page, child_transforms, cInstanceOrder), limits.smallVec);
+  }
+  std::fill(m_drawCounts.begin(), m_drawCounts.end(), DrawCounts {});
+
+  // Extent of drawing by low detail walk (of whole tree - not clipped)
+  WalkLimits extentLimits { limits };
+  extentLimits.maxOrder = std::min(cExtentOrder, limits.maxOrder);
+  extentLimits.clip.active = false;
+  extentLimits.lodSize = 0.0f;
+  extentLimits.instanceOrder = 0;
+  m_walks[0].walk_subtree(store, root, child_transforms, extentLimits, nullptr, 0,
+                          ExtentPass{minmax, limits, extentLimits.maxOrder});
+
+  if (workers() == 1) {
+    // Sequential walk
+    visited = m_walks[0].walk_subtree(store, root, child_transforms, limits, nullptr, 0,
+                                      DrawPass{store, batches.part(0), input.flashCtrl, input.palettes,
+                                               limits, m_impostors, m_instance, m_drawCounts[0]});
+  } else {
+    // First orders by calling thread (as worker 0) - collecting subtree roots
+    m_roots.clear();
+    visited = m_walks[0].walk_subtree(store, root, child_transforms, limits, &m_roots, cSplitOrder,
+                                      DrawPass{store, batches.part(0), input.flashCtrl, input.palettes,
+                                               limits, m_impostors, m_instance, m_drawCounts[0]});
+
+    // Subtrees in parallel
+    std::fill(m_visited.begin(), m_visited.end(), 0);
+    auto subtree = [&](long task, int worker) {
+      m_visited[worker] += m_walks[worker].walk_subtree(
+          store, m_roots[task], child_transforms, limits, nullptr, 0,
+          DrawPass{store, batches.part(worker), input.flashCtrl, input.palettes,
+                   limits, m_impostors, m_instance, m_drawCounts[worker]});
+    };
+    m_pool.run(static_cast<long>(m_roots.size()), subtree);
+
+    for (long worker_visited : m_visited) {
+      visited += worker_visited;
+    }
+  }
+  store.save_primary(prim);
+
+  m_culled = 0;
+  for (ElementsWalk & worker_walk : m_walks) {
+    m_culled += worker_walk.take_culled();
+  }
+  m_flashes = 0;
+  m_nodes.fill(0);
+  for (const DrawCounts & worker_counts : m_drawCounts) {
+    visited += worker_counts.instanced;
+    m_culled += worker_counts.culled;
+    m_flashes += worker_counts.flashes;
+    for (std::size_t order { 0 }; order < m_nodes.size(); ++order) {
+      m_nodes[order] += worker_counts.nodes[order];
+    }
+  }
+  return visited;
+}
@@ -0,0 +1,325 @@
+// Copyright (c) 2025-2026 Robert Gajewski
+// (MIT License)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "autoscale.h"
+#include "colors.h"
+#include "elem_store.h"
+#include "fractal.h"
+#include "instance.h"
+#include "lod.h"
+#include "stem_batch.h"
+#include "thread_pool.h"
+#include <array>
+#include <cmath>
+#include <vector>
+
+// Iterative traversal (visit) of fractal elements store
+// and passes which can be composed over it
+
+// Conservative bound of subtrees: whole drawn subtree of element of given
+// order lies within circle around element base x,y of radius
+// factor[order] * element vector length (plus stem thickness)
+struct SubtreeReach {
+  std::array<float, cFrac::NrOfOrders +1> factor {};
+
+  // Reach of every order from children transformations of frame
+  void set(const T_Child_Transform_Arr & child_transforms, long maxOrder);
+  // Radius of subtree of element (vector dx,dy)
+  float radius(float dx, float dy, long order) const;
+};
+
+// Visible rectangle of traversal - subtrees which cannot reach it
+// are neither visited nor created
+struct WalkClip {
+  bool active { false };
+  float x0 {}, y0 {}, x1 {}, y1 {};
+  // Circle of given radius around x,y entirely outside of rectangle
+  bool outside(float x, float y, float radius) const;
+};
+
+// Limits of traversal depth
+struct WalkLimits {
+  // Small vector - below this size children are not visited
+  // (typically TranAlg::s_SmallVect or s_SmallVecAnim)
+  float smallVec;
+  // Elements of higher orders have no children
+  long maxOrder { cFrac::NrOfOrders };
+  // Subtrees bound (see WalkClip and ExtentPass)
+  SubtreeReach reach {};
+  // Visible area (if active)
+  WalkClip clip {};
+  // Subtrees of smaller radius are drawn by LOD impostor (0 - off, see lod.h)
+  float lodSize { 0.0f };
+  // Children subtrees of elements of this order are drawn from instance
+  // (0 - off, see instance.h)
+  long instanceOrder { 0 };
+
+  // Children subtree of element is not walked but drawn by impostor
+  bool impostor(float dx, float dy, long order) const {
+    return lodSize > 0.0f and order < maxOrder and
+           std::abs(dx) + std::abs(dy) >= smallVec and
+           reach.factor[order] * std::hypot(dx, dy) < lodSize;
+  }
+  // Children subtree of element is not walked but drawn from instance
+  bool instanced(long order) const {
+    return instanceOrder > 0 and order == instanceOrder and order < maxOrder;
+  }
+};
+
+// Everything needed to compute (walk) single frame - snapshot of primary
+// element, algo and global light/colors state taken by main thread,
+// so the frame can be computed while the previous one is drawn
+struct FrameInput {
+  Element prim;  // updated by walk (primary transform and flash)
+  T_Fluctuate_Algo_Arr algo_fluct_data;    // primary element transform
+  T_Child_Transform_Arr child_transforms;  // all other elements
+  WalkLimits limits;
+  FlashCtrl flashCtrl;
+  StemPalettes palettes;
+};
+
+// Collect Min/Max of drawing for autoscale by low detail walk (up to cutOrder):
+// stems of elements without further children, subtree bound of the others
+// at cutOrder (see SubtreeReach) - conservative extent of whole drawing
+struct ExtentPass {
+  AutoScale::VecMinMax & minmax;
+  const WalkLimits & limits;  // of full detail walk
+  long cutOrder;
+  void operator()(const ElemRef & el) const {
+    const ElemStore::Page & pg { el.page };
+    const float x { pg.x[el.ind] };
+    const float y { pg.y[el.ind] };
+    const float dx { pg.dx[el.ind] };
+    const float dy { pg.dy[el.ind] };
+    const bool leaf { el.order >= limits.maxOrder or
+                      std::abs(dx) + std::abs(dy) < limits.smallVec };
+    if (el.order < cutOrder or leaf) {
+      AutoScale::extendMinMax(minmax, x, y, dx, dy);
+    } else {
+      const float radius { limits.reach.radius(dx, dy, el.order) };
+      AutoScale::extendMinMax(minmax, x - radius, y - radius, 2 * radius, 2 * radius);
+    }
+  }
+};
+
+// Counts of single worker DrawPass
+struct DrawCounts {
+  long instanced { 0 };  // stems drawn from instance (not visited by walk)
+  long culled { 0 };     // subtrees culled within instances
+  long flashes { 0 };    // stems with flash effect in progress
+  T_Order_Counts nodes {};  // stems drawn per order
+};
+
+// Append element stem (and impostor or instance of its subtree if not walked)
+// to the frame batch
+struct DrawPass {
+  const ElemStore & store;
+  StemBatch & batch;
+  const FlashCtrl & flashCtrl;
+  const StemPalettes & palettes;
+  const WalkLimits & limits;
+  const LodImpostors & impostors;
+  const SubtreeInstance & instance;
+  DrawCounts & counts;
+  void operator()(const ElemRef & el) const {
+    ElemStore::Page & pg { el.page };
+    const long i { el.ind };
+    const float x { pg.x[i] };
+    const float y { pg.y[i] };
+    const float dx { pg.dx[i] };
+    const float dy { pg.dy[i] };
+    const bool flashing { pg.flash[i].step(dx, dy, flashCtrl) };
+    if (pg.flash[i].flash_cnt > 0) {
+      ++counts.flashes;
+    }
+    ++counts.nodes[el.order];
+    batch.append_stem(el.order, flashing, x, y, dx, dy, store.thick(el.order, el.slot), palettes);
+    if (limits.impostor(dx, dy, el.order)) {
+      draw_impostor(x, y, dx, dy, el.order);
+    } else if (limits.instanced(el.order) and std::abs(dx) + std::abs(dy) >= limits.smallVec) {
+      draw_instance(x, y, dx, dy);
+    }
+  }
+
+  void draw_impostor(float x, float y, float dx, float dy, long order) const {
+    for (const LodImpostors::Point & pt : impostors.impostor(order)) {
+      batch.append_point({ x + pt.along * dx - pt.across * dy,
+                           y + pt.along * dy + pt.across * dx }, pt.color);
+    }
+  }
+  // Children subtree of element x,y,dx,dy under the same limits as walk
+  void draw_instance(float x, float y, float dx, float dy) const;
+};
+
+// Position of element in store
+struct ElemPos {
+  ElemStore::Page * page;
+  long order;
+  long slot;
+};
+
+// Traversal engine with explicit stack (instead of recursion).
+// Elements are visited depth-first in the same order as recursion did:
+// element, then all its DOWN branch subtrees, then UP branch subtrees.
+// Children of element are transformed together (consecutive slots of next
+// order columns) before being visited; then each visited element goes
+// through all passes: pass(const ElemRef &)
+// Children of elements bigger than limits are (lazily) created when needed.
+struct ElementsWalk {
+
+  ElementsWalk() {
+    // Max needed: # of children of every order on the path
+    m_stack.reserve(ElemStore::cChildren * (cFrac::NrOfOrders +1));
+  }
+
+  // Whole tree - returns # of visited elements
+  template<typename... Passes>
+  long walk(ElemStore & store, Element & prim, const T_Fluctuate_Algo_Arr & algo_fluct_data,
+            const T_Child_Transform_Arr & child_transforms,
+            const WalkLimits & limits, Passes &&... passes) {
+    store.load_primary(prim, algo_fluct_data);
+    const long visited { walk_subtree(store, {&store.page(0, 0), 0, 0}, child_transforms,
+                                      limits, nullptr, 0, passes...) };
+    store.save_primary(prim);
+    return visited;
+  }
+
+  // Subtree of (already transformed) root element - returns # of visited elements.
+  // If splitRoots given, elements of splitOrder are neither visited
+  // nor scanned but collected there (to be walked separately)
+  template<typename... Passes>
+  long walk_subtree(ElemStore & store, ElemPos root,
+                    const T_Child_Transform_Arr & child_transforms,
+                    const WalkLimits & limits, std::vector<ElemPos> * splitRoots,
+                    long splitOrder, Passes &&... passes) {
+    long visited { 0 };
+    m_stack.clear();
+    m_stack.push_back(root);
+
+    while (!m_stack.empty()) {
+      const ElemPos item { m_stack.back() };
+      m_stack.pop_back();
+
+      if (splitRoots != nullptr and item.order == splitOrder) {
+        splitRoots->push_back(item);
+        continue;
+      }
+
+      ElemStore::Page & pg { *item.page };
+      const long ind { item.slot % ElemStore::cPageSlots };
+      if (limits.clip.active and
+          limits.clip.outside(pg.x[ind], pg.y[ind],
+                              limits.reach.radius(pg.dx[ind], pg.dy[ind], item.order))) {
+        ++m_culled;
+        continue; // whole subtree not visible
+      }
+      ++visited;
+
+      // All passes in given order
+      (passes(ElemRef{pg, ind, item.slot, item.order}), ...);
+
+      if (item.order >= limits.maxOrder) {
+        continue; // no more branches to scan
+      }
+
+      // Take approx vector length : |dx| + |dy| ~ sqrt(dx2 + dy2)
+      auto approx_vec = std::abs(pg.dx[ind]) + std::abs(pg.dy[ind]);
+      // If size below threshold do not continue with children
+      if (approx_vec < limits.smallVec) {
+        continue;
+      }
+      // Small subtree drawn at once by impostor or instance (see DrawPass)
+      if (limits.impostor(pg.dx[ind], pg.dy[ind], item.order) or limits.instanced(item.order)) {
+        continue;
+      }
+
+      // if needed - create next subordinate braches level starting from current branch
+      ElemStore::Page * const children { store.children_page(item.order, item.slot) };
+      if (children == nullptr) {
+        continue;
+      }
+      store.transform_children(item.order, item.slot, child_transforms);
+
+      // pushed in reverse - to be visited DOWN branch first, from first element
+      const long first { ElemStore::first_child(item.slot) };
+      for (long child { ElemStore::cChildren -1 }; child >= 0; --child) {
+        m_stack.push_back({children, item.order +1, first + child});
+      }
+    }
+    return visited;
+  }
+
+  // # of subtrees culled (outside of clip) since previous call
+  long take_culled() {
+    const long culled { m_culled };
+    m_culled = 0;
+    return culled;
+  }
+
+private:
+  // Elements waiting for visit - storage kept between frames
+  std::vector<ElemPos> m_stack;
+  long m_culled { 0 };
+};
+
+
+// Parallel elements walk with Draw pass, preceded by low detail walk
+// (up to cExtentOrder) finding extent of drawing (see ExtentPass).
+// Elements of orders below cSplitOrder are visited by calling thread,
+// subtrees of cSplitOrder elements are tasks for work-stealing thread pool
+// (subtrees are independent given their root). Every worker has its own
+// stack and frame batch part.
+// Single worker is exactly sequential ElementsWalk.
+// With LOD on, small subtrees are drawn by impostors (see lod.h).
+// With instancing on, subtrees of cInstanceOrder elements are drawn from
+// single instance (see instance.h) - unless light is active, flash effect
+// needs state of every stem.
+struct ParallelWalk {
+  // Order of subtree roots - up to cChildren^cSplitOrder tasks
+  constexpr static long cSplitOrder { 2 };
+  // Order of low detail walk - up to cChildren^cExtentOrder elements
+  constexpr static long cExtentOrder { 4 };
+  // Order of instanced subtrees roots - up to cChildren^cInstanceOrder of them
+  constexpr static long cInstanceOrder { 3 };
+
+  // threads - # of walking threads (0 - all hardware threads)
+  // lodSize - subtrees radius (pixels) drawn by LOD impostors (0 - off)
+  // instancing - subtrees drawn from instance (see instance.h)
+  explicit ParallelWalk(int threads, float lodSize = 0.0f, bool instancing = false);
+
+  int workers() const { return m_pool.workers(); }
+
+  // Whole tree - returns # of visited elements; batches shall have workers() parts,
+  // Min/Max is extended (not reset) by extent of drawing
+  long walk(ElemStore & store, FrameInput & input, FrameBatches & batches,
+            AutoScale::VecMinMax & minmax);
+  // # of subtrees culled by last walk (see WalkClip)
+  long culled() const { return m_culled; }
+  // # of stems with flash effect in progress after last walk
+  long flashes() const { return m_flashes; }
+  // # of elements drawn per order by last walk
+  const T_Order_Counts & nodes() const { return m_nodes; }
+
+private:
+  ThreadPool m_pool;
+  LodImpostors m_impostors;
+  bool m_instancing;
+  SubtreeInstance m_instance;
+  std::vector<ElementsWalk> m_walks;
+  std::vector<long> m_visited;
+  std::vector<DrawCounts> m_drawCounts;
+  long m_culled { 0 };
+  long m_flashes { 0 };
+  T_Order_Counts m_nodes {};
+  // Roots of subtrees walked in parallel
+  std::vector<ElemPos> m_roots;
+};
@@ -26,7 +26,7 @@
 //                     _ _
 // calculation formula u*v for 2d vector is =(ux*vx + uy*vy)
 
-LightAngleCase StemFlash::light_vec_angle(float vx, float vy) {
+LightAngleCase FlashState::light_vec_angle(float vx, float vy, sf::Vector2i lightVec) {
 
   // If vector size is too small (single drawing point) assume AngleUnknown
   constexpr float cTooSmall = 1.2;
@@ -37,8 +37,8 @@ LightAngleCase StemFlash::light_vec_angle(float vx, float vy) {
   
   // take dot product between light vector and fractal (stem) vector
   float dot_product;
-  dot_product = (LightS::s_lightVec.x * vx) + 
-                (LightS::s_lightVec.y * vy);
+  dot_product = (lightVec.x * vx) + 
+                (lightVec.y * vy);
   
   // Debug
   // Dbg::report_trace("lvec.x = ", LightS::s_lightVec.x);
@@ -55,12 +55,12 @@ LightAngleCase StemFlash::light_vec_angle(float vx, float vy) {
 }
 
 
-// had angle between light rays and (this) vec was changed (<90 vs >90 deg)
-bool StemFlash::light_vec_angle_flip() {
+// had angle between light rays and given vec was changed (<90 vs >90 deg)
+bool FlashState::light_vec_angle_flip(float vx, float vy, sf::Vector2i lightVec) {
   bool ret = false;
   LightAngleCase curr_l_angle;
   
-  curr_l_angle = light_vec_angle(vec_xy.dx, vec_xy.dy);
+  curr_l_angle = light_vec_angle(vx, vy, lightVec);
 
   if ((prev_l_angle != lAngleUnknown) and
       (curr_l_angle != lAngleUnknown) and
@@ -33,8 +33,8 @@ void Vec2D::reposition(const float fraction) {
 void Stem::reposition_stem(const float fraction, Stem::ThickLevel level) {
   float thickness = 0.0;
 
-  if (level == Stem::thick2) { thickness = 0.006; } 
-  else if (level == Stem::thick1) { thickness = 0.008; }
+  if (level == Stem::thick2) { thickness = cThick2Fraction; } 
+  else if (level == Stem::thick1) { thickness = cThick1Fraction; }
   else { thickness = 0.0; }
 
   // creating width (optionally)
@@ -86,9 +86,10 @@ void Stem::shrinkStemCenter(float factor, float cumulativeFactor,
   
   vec_xy.dx *= factor; 
   vec_xy.dy *= factor;
-  // Copy used for primary element possible 'growing' transformation
-  vec_xy.originalDx = vec_xy.dx; 
-  vec_xy.originalDy = vec_xy.dy;
+  // Base of primary element possible 'growing' transformation
+  // (dx,dy is its scaled copy - shrunk the same way)
+  vec_xy.originalDx *= factor; 
+  vec_xy.originalDy *= factor;
 
   // Calculate coordinates of stem taking given width
   recalculateStemWidthCoordinates(cumulativeFactor);